@@ -2,13 +2,25 @@
 #define __BIG_INT_H__
 
 #include "utils.h"
+#include "kernels.h"
 
 // standard library
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <sstream>
 #include <string>
+#include <system_error>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 
@@ -47,10 +59,34 @@ class IBigIntLike { };
 template <typename T>
 concept is_BigInt_like = std::is_base_of_v<IBigIntLike, T>;
 
+class IBigIntExpression { };
+
+/// lazily evaluated values which BigInt can be constructed from and assigned, see LinearCombination.
+template <typename T>
+concept is_BigInt_expression = std::is_base_of_v<IBigIntExpression, T>;
+
 using utils::one_of;
 
 }
 
+namespace bigint::_private {
+
+/**
+ * BigInt-like types which store their digits contiguously in memory expose them as a span through digits().
+ * For those the algorithms work on the raw digits (and the limb kernels) instead of going through operator[] and set().
+ */
+template <typename T>
+concept has_contiguous_digits = requires(const T &value) {
+	{ value.digits() } -> std::same_as<std::span<const uint64_t>>;
+};
+
+template <typename T>
+concept has_mutable_contiguous_digits = requires(T &value) {
+	{ value.digits() } -> std::same_as<std::span<uint64_t>>;
+};
+
+}
+
 
 // forward declarations:
 namespace bigint {
@@ -129,6 +165,359 @@ neg(Sign sign) -> Sign {
 }
 
 
+// memory resource:
+namespace bigint::_private {
+
+/// where new digit storage of this thread comes from, nullptr for the global heap. Set through ScopedMemoryResource.
+inline thread_local std::pmr::memory_resource *current_memory_resource = nullptr;
+
+/**
+ * @brief allocates room for `count` digits. At runtime every heap block starts with a hidden word recording the memory resource
+ *        it came from, so deallocate_digits() returns it there, no matter which resource is current by then.
+ */
+CONSTEXPR_AUTO
+allocate_digits(std::size_t count) -> uint64_t* {
+	if (std::is_constant_evaluated()) {
+		return std::allocator<uint64_t>{}.allocate(count);
+	}
+	std::pmr::memory_resource *const resource = current_memory_resource;
+	static_assert(sizeof(resource) <= sizeof(uint64_t));
+	uint64_t *const block = (resource == nullptr)
+		? std::allocator<uint64_t>{}.allocate(count + 1)
+		: static_cast<uint64_t*>(resource->allocate((count + 1) * sizeof(uint64_t), alignof(uint64_t)));
+	::new (static_cast<void*>(block)) (std::pmr::memory_resource*)(resource);
+	return block + 1;
+}
+
+/**
+ * @brief the memory resource a heap block of allocate_digits() came from, nullptr for the global heap. Only valid at runtime.
+ */
+inline auto
+digits_resource(const uint64_t *digits) noexcept -> std::pmr::memory_resource* {
+	return *std::launder(reinterpret_cast<std::pmr::memory_resource* const*>(digits - 1));
+}
+
+CONSTEXPR_VOID
+deallocate_digits(uint64_t *digits, std::size_t count) noexcept {
+	if (std::is_constant_evaluated()) {
+		std::allocator<uint64_t>{}.deallocate(digits, count);
+		return;
+	}
+	uint64_t *const block = digits - 1;
+	std::pmr::memory_resource *const resource = digits_resource(digits);
+	if (resource == nullptr) {
+		std::allocator<uint64_t>{}.deallocate(block, count + 1);
+	} else {
+		resource->deallocate(block, (count + 1) * sizeof(uint64_t), alignof(uint64_t));
+	}
+}
+
+}
+
+
+// memory resource:
+namespace bigint {
+
+/**
+ * @brief while alive, all digit storage allocated on this thread comes from `resource`: the results of +, *, divmod(), pow() etc.
+ *        and the temporaries they create along the way. Values keep returning their storage to the resource it came from,
+ *        so they may outlive the scope, but not the resource. Scopes nest; nullptr selects the global heap.
+ *        As memory resources are usually not thread safe, multiplications do not use additional threads while a resource is set.
+ */
+class ScopedMemoryResource {
+public:
+	explicit
+	ScopedMemoryResource(std::pmr::memory_resource *resource) noexcept
+		: _previous(_private::current_memory_resource) {
+		_private::current_memory_resource = resource;
+	}
+
+	~ScopedMemoryResource() {
+		_private::current_memory_resource = _previous;
+	}
+
+	ScopedMemoryResource(const ScopedMemoryResource&) = delete;
+	ScopedMemoryResource& operator=(const ScopedMemoryResource&) = delete;
+
+private:
+	std::pmr::memory_resource *_previous;
+};
+
+/**
+ * @brief the memory resource new digit storage on this thread comes from, nullptr for the global heap.
+ */
+NODISCARD_AUTO
+memory_resource() noexcept -> std::pmr::memory_resource* {
+	return _private::current_memory_resource;
+}
+
+}
+
+
+// class SmallDigitVector:
+#ifndef BIGINT_INLINE_DIGITS
+#	define BIGINT_INLINE_DIGITS 1
+#endif
+
+namespace bigint::_private {
+
+/**
+ * @brief the digit storage of BigInt: a vector of digits which keeps up to N digits inline and only allocates once it grows beyond that,
+ *        so small values never touch the heap. The digits [0, size()) are always initialized.
+ *        The header is packed into 8 bytes: a 32-bit size, a 31-bit capacity and one spare bit for the owner (BigInt keeps its sign there),
+ *        so with N = 1 the whole vector takes 16 bytes.
+ */
+template <std::size_t N>
+class SmallDigitVector {
+	static_assert(N >= 1, "at least one digit must fit inline.");
+public:
+	constexpr
+	SmallDigitVector() noexcept {}
+
+	explicit constexpr
+	SmallDigitVector(std::size_t size) {
+		resize(size);
+	}
+
+	constexpr
+	SmallDigitVector(std::initializer_list<uint64_t> digits) {
+		reserve(digits.size());
+		for (const auto digit : digits) {
+			push_back(digit);
+		}
+	}
+
+	constexpr
+	SmallDigitVector(const SmallDigitVector &other) { // copy constructor
+		reserve(other._size);
+		copy_from(other);
+	}
+
+	constexpr
+	SmallDigitVector(SmallDigitVector &&other) noexcept { // move constructor
+		take_from(std::move(other));
+	}
+
+	constexpr
+	~SmallDigitVector() {
+		release();
+	}
+
+	CONSTEXPR_AUTO_DISCARD
+	operator=(const SmallDigitVector &other) -> SmallDigitVector& { // copy assignment, reuses the capacity if it suffices
+		if (this != &other) {
+			reserve(other._size);
+			copy_from(other);
+		}
+		return *this;
+	}
+
+	CONSTEXPR_AUTO_DISCARD
+	operator=(SmallDigitVector &&other) noexcept -> SmallDigitVector& { // move assignment
+		if (this != &other) {
+			release();
+			take_from(std::move(other));
+		}
+		return *this;
+	}
+
+	CONSTEXPR_AUTO
+	size() const noexcept -> std::size_t { return _size; }
+
+	CONSTEXPR_AUTO
+	capacity() const noexcept -> std::size_t { return _capacity; }
+
+	/**
+	 * @brief the spare bit. It is copied and moved along with the digits.
+	 */
+	CONSTEXPR_AUTO
+	flag() const noexcept -> bool { return _flag; }
+
+	CONSTEXPR_VOID
+	set_flag(bool flag) noexcept { _flag = flag; }
+
+	CONSTEXPR_AUTO
+	data() const noexcept -> const uint64_t* { return is_inline() ? _storage.inline_digits.data() : _storage.heap; }
+
+	CONSTEXPR_AUTO
+	data() noexcept -> uint64_t* { return is_inline() ? _storage.inline_digits.data() : _storage.heap; }
+
+	CONSTEXPR_AUTO
+	operator[](std::size_t index) const noexcept -> const uint64_t& { return data()[index]; }
+
+	CONSTEXPR_AUTO
+	operator[](std::size_t index) noexcept -> uint64_t& { return data()[index]; }
+
+	CONSTEXPR_AUTO
+	begin() const noexcept -> const uint64_t* { return data(); }
+
+	CONSTEXPR_AUTO
+	end() const noexcept -> const uint64_t* { return data() + _size; }
+
+	CONSTEXPR_VOID
+	push_back(uint64_t digit) {
+		if (_size == _capacity) {
+			reallocate(grown_capacity(_size + 1));
+		}
+		std::construct_at(data() + _size, digit);
+		++_size;
+	}
+
+	CONSTEXPR_VOID
+	pop_back() noexcept {
+		--_size;
+	}
+
+	CONSTEXPR_VOID
+	insert_front(uint64_t digit) {
+		if (_size == _capacity) {
+			reallocate(grown_capacity(_size + 1));
+		}
+		uint64_t *const digits = data();
+		if (_size > 0) {
+			std::construct_at(digits + _size, digits[_size - 1]);
+			std::copy_backward(digits, digits + _size - 1, digits + _size);
+		}
+		digits[0] = digit;
+		++_size;
+	}
+
+	/**
+	 * @brief new digits are zero.
+	 */
+	CONSTEXPR_VOID
+	resize(std::size_t size) {
+		if (size > _capacity) {
+			reallocate(grown_capacity(size));
+		}
+		uint64_t *const digits = data();
+		for (std::size_t i = _size; i < size; ++i) {
+			std::construct_at(digits + i, 0ull);
+		}
+		_size = uint32_t(size);
+	}
+
+	CONSTEXPR_VOID
+	reserve(std::size_t capacity) {
+		if (capacity > _capacity) {
+			reallocate(capacity);
+		}
+	}
+
+	/**
+	 * @brief the memory resource the digits were allocated from, nullptr if they are stored inline or on the global heap.
+	 *        Only valid at runtime.
+	 */
+	[[nodiscard]] auto
+	memory_resource() const noexcept -> std::pmr::memory_resource* {
+		return is_inline() ? nullptr : digits_resource(_storage.heap);
+	}
+
+	/**
+	 * @brief releases the unused capacity, moving the digits back inline if they fit.
+	 */
+	CONSTEXPR_VOID
+	shrink_to_fit() {
+		if (is_inline() || _size == _capacity) {
+			return;
+		}
+		if (_size > N) {
+			reallocate(_size);
+			return;
+		}
+		std::array<uint64_t, N> digits{};
+		std::copy(_storage.heap, _storage.heap + _size, digits.begin());
+		release();
+		_storage.inline_digits = digits;
+		_capacity = N;
+	}
+
+private:
+	union Storage {
+		std::array<uint64_t, N> inline_digits{};
+		uint64_t *heap;
+	} _storage;
+	uint32_t _size = 0;
+	uint32_t _capacity : 31 = N; // N if and only if the digits are stored inline
+	uint32_t _flag : 1 = 0;
+
+	static constexpr std::size_t max_capacity = (1ull << 31) - 1;
+
+	CONSTEXPR_AUTO
+	is_inline() const noexcept -> bool { return _capacity == N; }
+
+	CONSTEXPR_AUTO
+	grown_capacity(std::size_t min_capacity) const noexcept -> std::size_t {
+		if (min_capacity > max_capacity) {
+			return min_capacity; // only the growth is capped. reallocate() rejects the request itself.
+		}
+		return std::min(std::max<std::size_t>(min_capacity, _capacity + _capacity / 2), max_capacity);
+	}
+
+	/**
+	 * @brief moves the digits to a new heap allocation of the given capacity > N.
+	 */
+	CONSTEXPR_VOID
+	reallocate(std::size_t capacity) {
+		if (capacity > max_capacity) {
+			auto msg = utils::concat(
+				"too many digits.",
+				" capacity: ", capacity, " max: ", max_capacity, ".");
+			throw std::length_error(utils::error_msg(std::move(msg)));
+		}
+		uint64_t *const digits = allocate_digits(capacity);
+		const uint64_t *const old_digits = data();
+		for (std::size_t i = 0; i < _size; ++i) {
+			std::construct_at(digits + i, old_digits[i]);
+		}
+		release();
+		_storage.heap = digits;
+		_capacity = uint32_t(capacity);
+	}
+
+	CONSTEXPR_VOID
+	release() noexcept {
+		if (!is_inline()) {
+			deallocate_digits(_storage.heap, _capacity);
+		}
+	}
+
+	/**
+	 * @brief requires capacity() >= other.size().
+	 */
+	CONSTEXPR_VOID
+	copy_from(const SmallDigitVector &other) noexcept {
+		uint64_t *const digits = data();
+		for (std::size_t i = 0; i < other._size; ++i) {
+			std::construct_at(digits + i, other[i]);
+		}
+		_size = other._size;
+		_flag = other._flag;
+	}
+
+	/**
+	 * @brief requires that this does not own a heap allocation. Leaves other empty.
+	 */
+	CONSTEXPR_VOID
+	take_from(SmallDigitVector &&other) noexcept {
+		if (other.is_inline()) {
+			_storage.inline_digits = other._storage.inline_digits;
+		} else {
+			_storage.heap = other._storage.heap;
+			other._storage.inline_digits = {};
+		}
+		_size = other._size;
+		_capacity = other._capacity;
+		_flag = other._flag;
+		other._size = 0;
+		other._capacity = N;
+		other._flag = 0;
+	}
+};
+
+}
+
+
 // class BigInt:
 namespace bigint {
 
@@ -136,13 +525,47 @@ class BigInt : public IBigIntLike
 {
 
  public:
+	/**
+	 * @brief what sign() returns for a non-const BigInt. The sign is a single bit packed into the digit storage,
+	 *        so instead of a Sign& this proxy is returned. It converts to Sign and can be assigned a Sign.
+	 */
+	class SignReference {
+	public:
+		explicit constexpr
+		SignReference(BigInt &value) noexcept : _value(value) {}
+
+		constexpr
+		SignReference(const SignReference &other) noexcept = default;
+
+		constexpr
+		operator Sign() const noexcept {
+			return Sign(_value._data.flag());
+		}
+
+		CONSTEXPR_AUTO_DISCARD
+		operator=(Sign sign) noexcept -> SignReference& {
+			_value._data.set_flag(sign == Sign::NEG);
+			return *this;
+		}
+
+		CONSTEXPR_AUTO_DISCARD
+		operator=(const SignReference &other) noexcept -> SignReference& { // assigns the sign, not the reference
+			return *this = Sign(other);
+		}
+
+	private:
+		BigInt &_value;
+	};
+
 	constexpr
 	BigInt(): BigInt(0) {}
 
 	explicit constexpr
 	BigInt(uint64_t v, Sign sign=Sign::POS)
-		: _data({v}), _sign(sign)
-	{ }
+		: _data({v})
+	{
+		_data.set_flag(sign == Sign::NEG);
+	}
 
 	explicit constexpr
 		BigInt(std::signed_integral auto v)
@@ -157,24 +580,31 @@ class BigInt : public IBigIntLike
 	template<is_BigInt_like T>
 	explicit constexpr
 		BigInt(const T &v)
-		: _data(v.size()), _sign(v.sign()) {
+		: _data(v.size()) {
+		_data.set_flag(v.sign() == Sign::NEG);
 		for (size_t i = 0; i < v.size(); ++i) {
 			_data[i] = v[i];
 		}
 
 	}
 
+	template<is_BigInt_expression T>
+	explicit constexpr
+		BigInt(const T &expression) {
+		expression.evaluate_to(*this);
+	}
+
 	constexpr
 	~BigInt() {}
 
 	constexpr
 	BigInt(const BigInt &other) // copy constructor
-		: _data(other._data), _sign(other._sign) {
+		: _data(other._data) {
 	}
 
 	constexpr
-	BigInt(BigInt &&other) // move constructor
-		: _data(std::move(other._data)), _sign(other._sign) {
+	BigInt(BigInt &&other) noexcept // move constructor
+		: _data(std::move(other._data)) {
 	}
 
 	template<is_BigInt_like T>
@@ -185,28 +615,33 @@ class BigInt : public IBigIntLike
 		return *this;
 	}
 
+	template<is_BigInt_expression T>
 	CONSTEXPR_AUTO_DISCARD
-	operator=(const BigInt &other) -> BigInt& { // copy assignment
-		BigInt tmp(other);
-		swap(*this, tmp);
+	operator=(const T &expression) -> BigInt& { // evaluates into the existing storage
+		expression.evaluate_to(*this);
 		return *this;
 	}
 
 	CONSTEXPR_AUTO_DISCARD
-	operator=(BigInt &&other) -> BigInt& { // move assignment
-		BigInt tmp(std::move(other));
-		swap(*this, tmp);
+	operator=(const BigInt &other) -> BigInt& { // copy assignment, reuses the capacity if it suffices
+		_data = other._data;
+		return *this;
+	}
+
+	CONSTEXPR_AUTO_DISCARD
+	operator=(BigInt &&other) noexcept -> BigInt& { // move assignment
+		_data = std::move(other._data);
 		return *this;
 	}
 
 	CONSTEXPR_AUTO
 	sign() const noexcept -> Sign {
-		return _sign;
+		return Sign(_data.flag());
 	}
 
 	CONSTEXPR_AUTO
-	sign() noexcept -> Sign& {
-		return _sign;
+	sign() noexcept -> SignReference {
+		return SignReference{*this};
 	}
 
 	CONSTEXPR_AUTO
@@ -216,7 +651,21 @@ class BigInt : public IBigIntLike
 
 	CONSTEXPR_AUTO
 	operator[](std::size_t index) const noexcept -> uint64_t {
-		return (index >= size()) ? 0ull : _data.at(index);
+		return (index >= size()) ? 0ull : _data[index];
+	}
+
+	/**
+	 * @brief all size() digits, least significant first. Unlike set(), writing through the span is not bounds checked.
+	 *        The span is invalidated by anything that changes size().
+	 */
+	CONSTEXPR_AUTO
+	digits() const noexcept -> std::span<const uint64_t> {
+		return {_data.data(), _data.size()};
+	}
+
+	CONSTEXPR_AUTO
+	digits() noexcept -> std::span<uint64_t> {
+		return {_data.data(), _data.size()};
 	}
 
 	CONSTEXPR_VOID
@@ -227,21 +676,21 @@ class BigInt : public IBigIntLike
 				" size(): ", size(), " index: ", index, ".");
 			throw std::invalid_argument(utils::error_msg(std::move(msg)));
 		}
-		_data.at(index) = digit;
+		_data[index] = digit;
 	}
 
 	CONSTEXPR_VOID
 	append(uint64_t v) { _data.push_back(v); }
 
 	CONSTEXPR_VOID
-	insert_front(uint64_t v) { _data.insert(_data.cbegin(), v); }
+	insert_front(uint64_t v) { _data.insert_front(v); }
 
 	CONSTEXPR_VOID
 	remove_last() {
 		if (_data.size() > 1) {
 			_data.pop_back();
 		} else {
-			_data.at(0) = 0;
+			_data[0] = 0;
 		}
 	}
 
@@ -260,7 +709,35 @@ class BigInt : public IBigIntLike
 	BIGINT_TRACY_CONSTEXPR_VOID
 	resize(std::size_t size) {
 		BIGINT_TRACY_ZONE_SCOPED;
-		_data.resize(size, 0);
+		_data.resize(size);
+	}
+
+	/**
+	 * @brief the number of digits that fit without allocating. Assignments, resize() and cleanup() never give storage back,
+	 *        only shrink_to_fit() does.
+	 */
+	CONSTEXPR_AUTO
+	capacity() const noexcept -> std::size_t {
+		return _data.capacity();
+	}
+
+	CONSTEXPR_VOID
+	reserve(std::size_t capacity) {
+		_data.reserve(capacity);
+	}
+
+	CONSTEXPR_VOID
+	shrink_to_fit() {
+		_data.shrink_to_fit();
+	}
+
+	/**
+	 * @brief the memory resource the digits were allocated from, nullptr if they are stored inline or on the global heap.
+	 *        Only valid at runtime.
+	 */
+	[[nodiscard]] auto
+	storage_resource() const noexcept -> std::pmr::memory_resource* {
+		return _data.memory_resource();
 	}
 
 	friend CONSTEXPR_VOID
@@ -269,21 +746,19 @@ class BigInt : public IBigIntLike
 public:
 	[[nodiscard]] auto
 	__data_for_testing_only() const -> std::vector<uint64_t>{
-		auto result = _data;
+		std::vector<uint64_t> result(_data.begin(), _data.end());
 		result.push_back(is_neg(*this) ? 1 : 0);
 		return result;
 	}
 
 private:
-	std::vector<uint64_t> _data;
-	Sign _sign; // adds another 8 bytes :(
+	_private::SmallDigitVector<BIGINT_INLINE_DIGITS> _data; // the sign is stored in its spare bit
 };
 
 
 CONSTEXPR_VOID
 swap(BigInt& a, BigInt& b) noexcept {
 	std::swap(a._data, b._data);
-	std::swap(a._sign, b._sign);
 }
 
 }
@@ -302,6 +777,11 @@ copy_digits_to_from(TLHS &to, const TRHS& from) {
 		throw std::invalid_argument(utils::error_msg(std::move(msg)));
 	}
 
+	if constexpr (has_mutable_contiguous_digits<TLHS> && has_contiguous_digits<TRHS>) {
+		const auto from_digits = from.digits();
+		std::copy_backward(from_digits.begin(), from_digits.end(), to.digits().begin() + from_digits.size());
+		return;
+	}
 	for(auto i = from.size(); i --> 0;) {
 		to.set(i, from[i]);
 	}
@@ -320,7 +800,7 @@ class BigIntAdapter : public IBigIntLike
  public:
 	explicit constexpr
 	BigIntAdapter(T v) noexcept
-		: _data(v)
+		: _data(v), _digit(utils::constexpr_abs(v))
 	{ }
 
 	constexpr
@@ -328,24 +808,27 @@ class BigIntAdapter : public IBigIntLike
 
 	constexpr
 	BigIntAdapter(const BigIntAdapter &other) noexcept // copy constructor
-		: _data(other._data)
+		: _data(other._data), _digit(other._digit)
 	{ }
 
 	constexpr
 	BigIntAdapter(BigIntAdapter &&other) noexcept // copy constructor
-		: _data(std::move(other._data))
+		: _data(std::move(other._data)), _digit(other._digit)
 	{ }
 
 	CONSTEXPR_AUTO_DISCARD
 	operator=(const BigIntAdapter &other) noexcept -> BigIntAdapter& { // copy assignment
 		_data = other._data;
+		_digit = other._digit;
 		return *this;
 	}
 
 	CONSTEXPR_AUTO_DISCARD
 	operator=(BigIntAdapter &&other) noexcept -> BigIntAdapter& { // move assignment
 		_data = other._data;
+		_digit = other._digit;
 		other._data = 0; // maybe?
+		other._digit = 0;
 		return *this;
 	}
 
@@ -368,6 +851,11 @@ class BigIntAdapter : public IBigIntLike
 		return (index >= size()) ? 0 : utils::constexpr_abs(_data);
 	}
 
+	CONSTEXPR_AUTO
+	digits() const noexcept -> std::span<const uint64_t> {
+		return {&_digit, 1};
+	}
+
 private:
 	template<std::integral TT>
 	friend CONSTEXPR_VOID
@@ -375,6 +863,7 @@ private:
 
 private:
 	T _data;
+	uint64_t _digit; // abs(_data), so that digits() can point to it
 };
 
 
@@ -382,6 +871,7 @@ template<std::integral T>
 CONSTEXPR_VOID
 swap(BigIntAdapter<T>& a, BigIntAdapter<T>& b) noexcept {
 	std::swap(a._data, b._data);
+	std::swap(a._digit, b._digit);
 }
 
 
@@ -397,7 +887,7 @@ class BigIntAdapter2 : public IBigIntLike
  public:
 	explicit constexpr
 	BigIntAdapter2(uint64_t lo, uint64_t hi, Sign sign=Sign::POS) noexcept
-		 : _lo(lo), _hi(hi), _sign(sign)
+		 : _digits{lo, hi}, _sign(sign)
 	{ }
 
 	constexpr
@@ -405,27 +895,24 @@ class BigIntAdapter2 : public IBigIntLike
 
 	constexpr
 	BigIntAdapter2(const BigIntAdapter2 &other) noexcept // copy constructor
-		: _lo(other._lo), _hi(other._hi)
+		: _digits(other._digits), _sign(other._sign)
 	{ }
 
 	constexpr
 	BigIntAdapter2(BigIntAdapter2 &&other) noexcept // copy constructor
-		: _lo(std::move(other._lo)), _hi(std::move(other._hi))
+		: _digits(std::move(other._digits)), _sign(other._sign)
 	{ }
 
 	CONSTEXPR_AUTO_DISCARD
 	operator=(const BigIntAdapter2 &other) noexcept -> BigIntAdapter2& { // copy assignment
-		_lo = other._lo;
-		_hi = other._hi;
+		_digits = other._digits;
 		return *this;
 	}
 
 	CONSTEXPR_AUTO_DISCARD
 	operator=(BigIntAdapter2 &&other) noexcept -> BigIntAdapter2& { // move assignment
-		_lo = other._lo;
-		_hi = other._hi;
-		other._lo = 0; // maybe?
-		other._hi = 0; // maybe?
+		_digits = other._digits;
+		other._digits = {0, 0}; // maybe?
 		return *this;
 	}
 
@@ -436,19 +923,17 @@ class BigIntAdapter2 : public IBigIntLike
 
 	CONSTEXPR_AUTO
 	size() const noexcept -> std::size_t {
-		return _hi != 0 ? 2 : 1;
+		return _digits[1] != 0 ? 2 : 1;
 	}
 
 	CONSTEXPR_AUTO
 	operator[](std::size_t index) const noexcept -> uint64_t {
-		switch (index) {
-		case 0:
-			return _lo;
-		case 1:
-			return _hi;
-		default:
-			return 0;
-		}
+		return (index >= 2) ? 0 : _digits[index];
+	}
+
+	CONSTEXPR_AUTO
+	digits() const noexcept -> std::span<const uint64_t> {
+		return {_digits.data(), size()};
 	}
 
 	CONSTEXPR_VOID
@@ -459,13 +944,7 @@ class BigIntAdapter2 : public IBigIntLike
 				" size(): ", size(), " index: ", index, ".");
 			throw std::invalid_argument(utils::error_msg(std::move(msg)));
 		}
-		switch (index) {
-		case 0:
-			_lo = digit; return;
-		case 1:
-			_hi = digit; return;
-		}
-		// we cannot get here
+		_digits[index] = digit;
 	}
 
 private:
@@ -473,16 +952,14 @@ private:
 	swap(BigIntAdapter2& a, BigIntAdapter2& b) noexcept;
 
 private:
-	uint64_t _lo;
-	uint64_t _hi;
+	std::array<uint64_t, 2> _digits; // lo, hi
 	Sign _sign;
 };
 
 
 CONSTEXPR_VOID
 swap(BigIntAdapter2& a, BigIntAdapter2& b) noexcept {
-	std::swap(a._lo, b._lo);
-	std::swap(a._hi, b._hi);
+	std::swap(a._digits, b._digits);
 	std::swap(a._sign, b._sign);
 }
 
@@ -634,7 +1111,7 @@ public:
 	}
 
 	CONSTEXPR_AUTO
-	sign() noexcept -> Sign& {
+	sign() noexcept -> decltype(auto) {
 		return lhs().sign();
 	}
 
@@ -679,7 +1156,7 @@ public:
 	}
 
 	CONSTEXPR_AUTO
-	sign() noexcept -> Sign& {
+	sign() noexcept -> decltype(auto) {
 		return lhs().sign();
 	}
 
@@ -718,6 +1195,16 @@ public:
 		lhs().cleanup();
 	}
 
+	CONSTEXPR_AUTO
+	digits() const noexcept -> std::span<const uint64_t> requires has_contiguous_digits<T_Plain> {
+		return lhs().digits().subspan(_rhs);
+	}
+
+	CONSTEXPR_AUTO
+	digits() noexcept -> std::span<uint64_t> requires has_mutable_contiguous_digits<T_Plain> && (!std::is_const_v<std::remove_reference_t<T>>) {
+		return lhs().digits().subspan(_rhs);
+	}
+
 private:
 	T _lhs;
 	uint64_t _rhs;
@@ -762,18 +1249,26 @@ rshifted(TLHS&& a, uint64_t b) {
 }
 
 
-// abs(), neg:
+// slices:
 namespace bigint::_private {
 
+/**
+ * @brief a positive, read-only view of the digits [start, start + len) of another BigInt-like value.
+ *        Leading zero digits are not part of the view, so that is_zero() & friends work as expected.
+ */
 template <typename T>
-class BigIntAbs: IBigIntLike {
+class BigIntSlice : IBigIntLike {
 	using T_Plain = std::remove_cvref_t<T>;
 public:
-	constexpr BigIntAbs(T_Plain&& lhs) :
-		_lhs(std::move(lhs)) {}
-
-	constexpr BigIntAbs(const T_Plain& lhs) :
-		_lhs(lhs) {}
+	constexpr BigIntSlice(const T_Plain& lhs, const std::size_t start, const std::size_t len) :
+		_lhs(lhs), _start(start), _len(len) {
+		while (_len > 1 && _lhs[_start + _len - 1] == 0) {
+			--_len;
+		}
+		if (_len == 0) {
+			_len = 1;
+		}
+	}
 
 	CONSTEXPR_AUTO
 	sign() const noexcept -> Sign {
@@ -782,24 +1277,98 @@ public:
 
 	CONSTEXPR_AUTO
 	size() const noexcept -> std::size_t {
-		return lhs().size();
+		return _len;
 	}
 
 	CONSTEXPR_AUTO
 	operator[](std::size_t index) const -> uint64_t {
-		return lhs()[index];
+		return (index >= _len) ? 0 : _lhs[_start + index];
 	}
 
-private:
-	T _lhs;
+	CONSTEXPR_AUTO
+	base() const noexcept -> const T_Plain& { return _lhs; }
 
 	CONSTEXPR_AUTO
-	lhs() const -> const T_Plain& { return _lhs; }
-};
+	start() const noexcept -> std::size_t { return _start; }
 
-template <typename T>
-class BigIntNeg: IBigIntLike {
-	using T_Plain = std::remove_cvref_t<T>;
+	CONSTEXPR_AUTO
+	digits() const noexcept -> std::span<const uint64_t> requires has_contiguous_digits<T_Plain> {
+		if (_start >= _lhs.size()) {
+			return {&_zero, 1};
+		}
+		return _lhs.digits().subspan(_start, _len);
+	}
+
+private:
+	const T_Plain& _lhs;
+	std::size_t _start;
+	std::size_t _len;
+
+	static constexpr uint64_t _zero = 0; // the only digit of a slice past the end of _lhs
+};
+
+
+template <is_BigInt_like TLHS>
+CONSTEXPR_AUTO
+sliced(const TLHS& a, std::size_t start, std::size_t len) {
+	return BigIntSlice<TLHS>(a, start, std::min(len, a.size() - std::min(start, a.size())));
+}
+
+/**
+ * slicing a slice yields a slice of the original value, so recursive algorithms do not create ever deeper nested view types.
+ */
+template <typename T>
+CONSTEXPR_AUTO
+sliced(const BigIntSlice<T>& a, std::size_t start, std::size_t len) {
+	return BigIntSlice<T>(a.base(), a.start() + start, std::min(len, a.size() - std::min(start, a.size())));
+}
+
+}
+
+
+// abs(), neg:
+namespace bigint::_private {
+
+template <typename T>
+class BigIntAbs: IBigIntLike {
+	using T_Plain = std::remove_cvref_t<T>;
+public:
+	constexpr BigIntAbs(T_Plain&& lhs) :
+		_lhs(std::move(lhs)) {}
+
+	constexpr BigIntAbs(const T_Plain& lhs) :
+		_lhs(lhs) {}
+
+	CONSTEXPR_AUTO
+	sign() const noexcept -> Sign {
+		return Sign::POS;
+	}
+
+	CONSTEXPR_AUTO
+	size() const noexcept -> std::size_t {
+		return lhs().size();
+	}
+
+	CONSTEXPR_AUTO
+	operator[](std::size_t index) const -> uint64_t {
+		return lhs()[index];
+	}
+
+	CONSTEXPR_AUTO
+	digits() const noexcept -> std::span<const uint64_t> requires has_contiguous_digits<T_Plain> {
+		return lhs().digits();
+	}
+
+private:
+	T _lhs;
+
+	CONSTEXPR_AUTO
+	lhs() const -> const T_Plain& { return _lhs; }
+};
+
+template <typename T>
+class BigIntNeg: IBigIntLike {
+	using T_Plain = std::remove_cvref_t<T>;
 public:
 	constexpr BigIntNeg(T_Plain&& lhs) :
 		_lhs(std::move(lhs)) {}
@@ -862,6 +1431,7 @@ operator-(TLHS&& a) {
 }
 
 
+
 // bitwise shift operations:
 namespace bigint {
 
@@ -890,6 +1460,13 @@ operator<<(const TLHS &a, uint64_t digits) -> BigInt {
 	BigInt result{0, a.sign()};
 	result.resize(a.size() + start);
 	digits %= 64;
+	if constexpr (_private::has_contiguous_digits<TLHS>) {
+		const auto last = kernels::lshift(result.digits().data() + start, a.digits().data(), a.size(), unsigned(digits));
+		if (last != 0) {
+			result.append(last);
+		}
+		return result;
+	}
 	result.set(start, a[0] << digits);
 	for (uint64_t i = 1; i < a.size(); ++i) {
 		const uint64_t lo = _private::rshift_safe(a[i-1], 64-digits);
@@ -915,6 +1492,13 @@ operator>>(const TLHS &a, uint64_t digits) -> BigInt {
 	result.resize(a.size() - start);
 
 	digits %= 64;
+	if constexpr (_private::has_contiguous_digits<TLHS>) {
+		kernels::rshift(result.digits().data(), a.digits().data() + start, a.size() - start, unsigned(digits));
+		if (result[result.size()-1] == 0) {
+			result.remove_last();
+		}
+		return result;
+	}
 	for (uint64_t i = start; i < a.size()-1; ++i) {
 		const uint64_t lo = a[i] >> digits;
 		const uint64_t hi = _private::lshift_safe(a[i+1], 64-digits);
@@ -944,6 +1528,18 @@ operator<<=(TLHS &a, uint64_t digits) -> TLHS& {
 
 	a.resize(a.size() + start);
 
+	if constexpr (_private::has_mutable_contiguous_digits<TLHS>) {
+		uint64_t *const data = a.digits().data();
+		const auto last = kernels::lshift(data + start, data, asize, unsigned(digits));
+		for (uint64_t i = start; i --> 0;) {
+			data[i] = 0;
+		}
+		if (last != 0) {
+			a.append(last);
+		}
+		return a;
+	}
+
 	const auto last = _private::rshift_safe(a[asize-1], 64-digits);
 	if (digits > 0 && last != 0) {
 		a.append(last);
@@ -977,6 +1573,15 @@ operator>>=(TLHS &a, uint64_t digits) -> TLHS& {
 	}
 
 	digits %= 64;
+	if constexpr (_private::has_mutable_contiguous_digits<TLHS>) {
+		uint64_t *const data = a.digits().data();
+		kernels::rshift(data, data + start, a.size() - start, unsigned(digits));
+		a.resize(a.size() - start);
+		if (a[a.size()-1] == 0) {
+			a.remove_last();
+		}
+		return a;
+	}
 	for (uint64_t i = start; i < a.size()-1; ++i) {
 		const uint64_t lo = a[i] >> digits;
 		const uint64_t hi = _private::lshift_safe(a[i+1], 64-digits);
@@ -1011,7 +1616,7 @@ operator<=>(const TLHS &a, const TRHS &b) -> std::strong_ordering {
 		for (i = std::max(a.size(), b.size()); i-->1 && a[i] == b[i];) {
 			// do nothin'
 		}
-		return a[i] <=> b[i];
+		return (a.sign() == Sign::NEG) ? b[i] <=> a[i] : a[i] <=> b[i];
 	}
 
 	return (is_neg(a) || is_pos(b)) ? std::strong_ordering::less : std::strong_ordering::greater;
@@ -1060,7 +1665,7 @@ operator<=>(const TLHS &a, TRHS b) -> std::strong_ordering {
 	if (a.size() > 1) {
 		return is_neg(a) ? std::strong_ordering::less : std::strong_ordering::greater;
 	} else if (is_neg(a)) {
-		return (b < 0) ? a[0] <=> uint64_t(-b) : std::strong_ordering::less;
+		return (b < 0) ? utils::constexpr_abs(b) <=> a[0] : std::strong_ordering::less;
 	} else {
 		return (b < 0) ? std::strong_ordering::greater : a[0] <=> uint64_t(b);
 	}
@@ -1119,10 +1724,13 @@ BIGINT_TRACY_CONSTEXPR_VOID
 add_ignore_sign(TRES &result, TLHS &a, TRHS &b) {
 	BIGINT_TRACY_ZONE_SCOPED;
 	uint8_t c = 0; // carry
-	for (auto i = 0ull; i < result.size(); i++) {
-		const auto ai = a[i];
-		result.set(i, ai + b[i] + c);
-		c = (result[i] < ai || (c && result[i] == ai)) ? 1: 0;
+	auto i = 0ull;
+	if constexpr (has_mutable_contiguous_digits<TRES> && has_contiguous_digits<TLHS> && has_contiguous_digits<TRHS>) {
+		i = std::min({result.size(), a.size(), b.size()});
+		c = uint8_t(kernels::add_n(result.digits().data(), a.digits().data(), b.digits().data(), i));
+	}
+	for (; i < result.size(); i++) {
+		result.set(i, utils::add_carry(a[i], b[i], c));
 	}
 	if (c) {
 		result.append(c);
@@ -1140,10 +1748,13 @@ template <is_BigInt_like TRES, is_BigInt_like TLHS, is_BigInt_like TRHS>
 CONSTEXPR_VOID
 _sub_ignore_sign_no_gegative_result_private(TRES &result, TLHS &a, TRHS &b) {
 	uint8_t c = 0; // carry
-	for (auto i = 0ull; i < result.size(); i++) {
-		const auto ai = a[i];
-		result.set(i, ai - b[i] - c);
-		c = (result[i] > ai || (c && result[i] == ai)) ? 1: 0;
+	auto i = 0ull;
+	if constexpr (has_mutable_contiguous_digits<TRES> && has_contiguous_digits<TLHS> && has_contiguous_digits<TRHS>) {
+		i = std::min({result.size(), a.size(), b.size()});
+		c = uint8_t(kernels::sub_n(result.digits().data(), a.digits().data(), b.digits().data(), i));
+	}
+	for (; i < result.size(); i++) {
+		result.set(i, utils::sub_borrow(a[i], b[i], c));
 	}
 	if (c) { // should NEVER happen.
 		auto msg = utils::concat(
@@ -1238,6 +1849,42 @@ operator+=(TLHS &a, const TRHS &b) -> TLHS& {
 	return a;
 }
 
+// an expiring operand lends its storage to the result:
+
+template <std::integral TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator+(BigInt &&a, TRHS b) -> BigInt {
+	a += b;
+	return std::move(a);
+}
+
+template <std::integral TLHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator+(TLHS a, BigInt &&b) -> BigInt {
+	b += a;
+	return std::move(b);
+}
+
+template <is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator+(BigInt &&a, const TRHS &b) -> BigInt {
+	a += b;
+	return std::move(a);
+}
+
+template <is_BigInt_like TLHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator+(const TLHS &a, BigInt &&b) -> BigInt {
+	b += a;
+	return std::move(b);
+}
+
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator+(BigInt &&a, BigInt &&b) -> BigInt {
+	a += b;
+	return std::move(a);
+}
+
 }
 
 
@@ -1304,567 +1951,3603 @@ operator-=(TLHS &a, const TRHS &b) -> TLHS& {
 	return a;
 }
 
+// an expiring operand lends its storage to the result, a - b is computed as -(b - a) when only b expires:
 
-}
-
-
-// sign handing for multiplication & division:
-namespace bigint::_private {
-
-CONSTEXPR_AUTO
-mult_sign(Sign a, Sign b) -> Sign {
-	return a != b ? Sign::NEG : Sign::POS;
-}
-
-}
-
-// multiplication:
-namespace bigint {
-
+template <std::integral TRHS>
 BIGINT_TRACY_CONSTEXPR_AUTO
-mult(uint64_t a, uint64_t b) -> BigIntAdapter2 {
-	BIGINT_TRACY_ZONE_SCOPED;
-	const auto a_0 = a & 0xFFFFFFFFull;
-	const auto a_1 = a >> 32;
-	const auto b_0 = b & 0xFFFFFFFFull;
-	const auto b_1 = b >> 32;
-	const uint64_t r_00 = a_0 * b_0;
-	const uint64_t r_01 = a_0 * b_1;
-	const uint64_t r_10 = a_1 * b_0;
-	const uint64_t r_11 = a_1 * b_1;
-
-	auto c = r_11 >> 0;
-	c += r_01 >> 32;
-	c += r_10 >> 32;
-
-	auto r = r_00 << 0;
-	r += r_01 << 32;
-	c += (r < (r_01 << 32)) ? 1 : 0;
-	r += r_10 << 32;
-	c += (r < (r_10 << 32)) ? 1 : 0;
-	if (c != 0)
-		return BigIntAdapter2{r, c};
-	else
-		return BigIntAdapter2{r, 0};
+operator-(BigInt &&a, TRHS b) -> BigInt {
+	a -= b;
+	return std::move(a);
 }
 
-template <is_BigInt_like TRES, is_BigInt_like TLHS>
-BIGINT_TRACY_CONSTEXPR_VOID
-mult(TRES &result, TLHS &a, uint64_t b) {
-	BIGINT_TRACY_ZONE_SCOPED;
-	if (b == 0 || is_zero(a)) {
-		result = BigInt{};
-		return;
-	}
-	result.resize(a.size());
-
-	uint64_t c = 0; // carry
-	for (auto i = 0ull; i < a.size(); i++) {
-		const auto rc = mult(a[i], b);
-		result.set(i, rc[0] + c);
-		c = rc[1] + (result[i] < c ? 1 : 0); // account for addition overflow
+template <std::integral TLHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator-(TLHS a, BigInt &&b) -> BigInt {
+	b -= a;
+	if (!is_zero(b)) {
+		b.sign() = _private::neg(b.sign());
 	}
-	if (c){
-		result.append(c);
-	};
-	result.sign() = a.sign();
-	result.cleanup();
+	return std::move(b);
 }
 
-template <is_BigInt_like TRES, is_BigInt_like TLHS>
-BIGINT_TRACY_CONSTEXPR_VOID
-mult(TRES &result, TLHS &a, int64_t b) {
-	mult(result, a, (uint64_t)llabs(b));
-	if (b < 0) {
-		result.sign() = _private::neg(result.sign());
-	}
+template <is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator-(BigInt &&a, const TRHS &b) -> BigInt {
+	a -= b;
+	return std::move(a);
 }
 
-template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+template <is_BigInt_like TLHS>
 BIGINT_TRACY_CONSTEXPR_AUTO
-mult(const TLHS &a, const TRHS &b) -> BigInt {
-	BIGINT_TRACY_ZONE_SCOPED;
-	if (is_zero(a) || is_zero(b)) {
-		return BigInt{};
-	}
-	BigInt result;
-	result.resize(a.size() + b.size());
-
-	for (auto i = 0ull; i < b.size(); i++) {
-		auto temp = a * b[i];
-		auto lshifted_temp = _private::lshifted(temp, i);
-		_private::add_ignore_sign(result, result, lshifted_temp);
+operator-(const TLHS &a, BigInt &&b) -> BigInt {
+	b -= a;
+	if (!is_zero(b)) {
+		b.sign() = _private::neg(b.sign());
 	}
-	result.sign() = _private::mult_sign(a.sign(), b.sign());
-	result.cleanup();
-	return result;
+	return std::move(b);
 }
 
-template <is_BigInt_like TLHS, std::integral TRHS>
 BIGINT_TRACY_CONSTEXPR_AUTO
-operator*(const TLHS &a, TRHS b) -> BigInt {
-	using TRHS2 = std::conditional_t<std::is_unsigned_v<TRHS>, uint64_t, int64_t>;
-	BigInt result;
-	mult(result, const_cast<TLHS&>(a), (TRHS2)b);
-	return result;
+operator-(BigInt &&a, BigInt &&b) -> BigInt {
+	a -= b;
+	return std::move(a);
 }
 
-template <std::integral TLHS, is_BigInt_like TRHS>
-BIGINT_TRACY_CONSTEXPR_AUTO
-operator*(TLHS a, const TRHS &b) -> BigInt {
-	return b * a;
-}
 
-template <is_BigInt_like TLHS, is_BigInt_like TRHS>
-BIGINT_TRACY_CONSTEXPR_AUTO
-operator*(const TLHS &a, const TRHS &b) -> BigInt {
-	return mult(a, b);
 }
 
-template <is_BigInt_like TLHS, std::integral TRHS>
-BIGINT_TRACY_CONSTEXPR_AUTO_DISCARD
-operator*=(TLHS &a, TRHS b) -> TLHS& {
-	using TRHS2 = std::conditional_t<std::is_unsigned_v<TRHS>, uint64_t, int64_t>;
-	mult(a, a, (TRHS2)b);
-	return a;
-}
 
-template <is_BigInt_like TRHS>
-BIGINT_TRACY_CONSTEXPR_AUTO_DISCARD
-operator*=(BigInt &a, const TRHS &b) -> BigInt& {
-	a = std::move(mult(a, b));
-	return a;
-}
+// expression templates:
+namespace bigint::_private {
 
+/**
+ * @brief whether `ptr` points into [digits, digits + capacity). Only valid at runtime.
+ */
+NODISCARD_AUTO
+points_into(const uint64_t *ptr, const uint64_t *digits, std::size_t capacity) -> bool {
+	const std::less<const uint64_t*> less;
+	return !less(ptr, digits) && less(ptr, digits + capacity);
 }
 
+/**
+ * @brief one summand of a LinearCombination: ±factor * (value << shift).
+ */
+template <is_BigInt_like T> requires has_contiguous_digits<T>
+struct ScaledTerm {
+	const T &value;
+	uint64_t factor = 1;
+	bool negate = false;
+	uint64_t shift = 0; // in bits
 
-// DivModResult:
-namespace bigint {
+	CONSTEXPR_AUTO
+	is_negative() const -> bool {
+		return (value.sign() == Sign::NEG) != negate;
+	}
 
-template<class D, class R=D>
-struct DivModResult {
-	typedef D _D;
-	typedef R _R;
-	D d; R r;
+	/// the number of digits the magnitude of the term can occupy.
+	CONSTEXPR_AUTO
+	size() const -> std::size_t {
+		return value.size() + shift / 64 + 2;
+	}
+
+	/**
+	 * @brief whether the digits of the term lie in [digits, digits + capacity).
+	 */
+	NODISCARD_AUTO
+	overlaps(const uint64_t *digits, std::size_t capacity) const -> bool {
+		return points_into(value.digits().data(), digits, capacity);
+	}
 };
 
+/**
+ * @brief digits = -digits modulo 2^(64 * digits.size()).
+ */
+CONSTEXPR_VOID
+negate_twos_complement(std::span<uint64_t> digits) noexcept {
+	uint8_t borrow = 0;
+	for (auto &digit : digits) {
+		digit = utils::sub_borrow(0, digit, borrow);
+	}
 }
 
+/**
+ * @brief reads the digits of result as a two's complement number and gives result the corresponding sign and magnitude.
+ */
+CONSTEXPR_VOID
+from_twos_complement(BigInt &result) {
+	const auto digits = result.digits();
+	result.sign() = Sign::POS;
+	if (!digits.empty() && (digits.back() >> 63) != 0) {
+		negate_twos_complement(digits);
+		result.sign() = Sign::NEG;
+	}
+	result.cleanup();
+}
 
-// divmod ignoring sign:
-namespace bigint::_private {
+/**
+ * @brief dest += factor * (x << 64 * offset), or -= if negative, modulo 2^(64 * dest.size()). Requires x.size() + offset < dest.size().
+ */
+CONSTEXPR_VOID
+accumulate_scaled(std::span<uint64_t> dest, std::span<const uint64_t> x, std::size_t offset, uint64_t factor, bool negative) {
+	if (x.empty() || factor == 0) {
+		return;
+	}
+	uint64_t *const r = dest.data() + offset;
+	uint64_t carry = 0;
+	if (factor == 1) {
+		carry = negative ? kernels::sub_n(r, r, x.data(), x.size()) : kernels::add_n(r, r, x.data(), x.size());
+	} else {
+		carry = negative ? kernels::submul_1(r, x.data(), x.size(), factor) : kernels::addmul_1(r, x.data(), x.size(), factor);
+	}
+	for (auto i = offset + x.size(); carry != 0 && i < dest.size(); ++i) {
+		uint8_t c = 0;
+		dest[i] = negative ? utils::sub_borrow(dest[i], carry, c) : utils::add_carry(dest[i], carry, c);
+		carry = c;
+	}
+}
 
 /**
- * @brief copy n most-significant digits (prefix) from s to d
- * @param d destination
- * @param s source
- * @param n number of digits
+ * @brief dest += term in two's complement. factor * 2^(shift % 64) is split into two digits, so every term costs
+ *        one or two passes of the add/sub(mul) kernels over its digits, and no shifted copy.
  */
-template <is_BigInt_like TLHS, is_BigInt_like TRHS>
-BIGINT_TRACY_CONSTEXPR_AUTO
-_prefix(TLHS& d, const TRHS& s, size_t n) {
-	d.resize(n);
-	_private::copy_digits_to_from(d, _private::rshifted(s, s.size() - n));
+template <is_BigInt_like T>
+CONSTEXPR_VOID
+accumulate_term(std::span<uint64_t> dest, const ScaledTerm<T> &term) {
+	const auto bits = unsigned(term.shift % 64);
+	const uint64_t low = term.factor << bits;
+	const uint64_t high = (bits == 0) ? 0 : term.factor >> (64 - bits);
+	const auto offset = term.shift / 64;
+	accumulate_scaled(dest, term.value.digits(), offset, low, term.is_negative());
+	accumulate_scaled(dest, term.value.digits(), offset + 1, high, term.is_negative());
 }
 
-template <is_BigInt_like TLHS, is_BigInt_like TRHS>
-BIGINT_TRACY_CONSTEXPR_AUTO
-_correct_d_and_subtract(TLHS& x, const TRHS& b, uint64_t d) -> uint64_t {
-	// all values are guaranteed to be positive.
-	x -= b * d;
-	if (is_neg(x)) {
-		x += b;
-		d -= 1;
-		if (is_neg(x)) {
-			x += b;
-			d -= 1;
+/**
+ * @brief result = the sum of the terms. The digits of result, sized for the largest term plus a carry digit, hold the sum
+ *        in two's complement while the terms are added one by one; its sign is restored at the end.
+ *        If `in_place`, the first term is result itself (shifted by less than a digit), which is scaled where it is.
+ */
+template <is_BigInt_like T, is_BigInt_like... Ts>
+CONSTEXPR_VOID
+evaluate_terms(BigInt &result, bool in_place, const ScaledTerm<T> &first, const ScaledTerm<Ts>&... terms) {
+	const std::size_t size = std::max({first.size(), terms.size()...}) + 1;
+	if (in_place) {
+		const bool negative = first.is_negative();
+		const auto digits = result.size();
+		result.resize(size);
+		const auto all = result.digits();
+		const uint64_t factor = first.factor << first.shift;
+		all[digits] = kernels::mul_1(all.data(), all.data(), digits, factor);
+		if (negative) {
+			negate_twos_complement(all);
 		}
+	} else {
+		result.resize(size);
+		std::fill(result.digits().begin(), result.digits().end(), 0);
+		accumulate_term(result.digits(), first);
 	}
-	// x is now positive again and (t = bd) holds.
-	return d;
+	(accumulate_term(result.digits(), terms), ...);
+	from_twos_complement(result);
 }
 
-// forward declaration:
-template <is_BigInt_like TLHS, is_BigInt_like TRHS, bool ignore_quotient, bool ignore_remainder>
-BIGINT_TRACY_CONSTEXPR_AUTO
-divmod_ignore_sign(const TLHS& aa, const TRHS& bb) -> DivModResult<BigInt>;
+}
 
 
+// expression templates:
+namespace bigint {
+
 /**
- * @brief division algorithm adapted from Nitin Verma, 2021, Implementing Basic Arithmetic for Large Integers: Division
- * @param a the dividend
- * @param b the divisor
- * @param e estimator (?) for the divisor
- * @param f
- * @return
+ * @brief a sum of scaled and shifted BigInt-like values, built by lazy() and the operators below.
+ *        Nothing is computed until the combination is assigned to a BigInt, which then accumulates the terms directly in its own digits,
+ *        without any intermediate values: `r = lazy(a) + b + c;`, `r = lazy(a) * k + c;` or `r = (lazy(a) << 5) - b;`.
+ *        The combination only refers to its operands, so it must be evaluated while they are alive, usually in the same statement.
+ *        Operands must expose their digits(); views without them (negation, left shift) are expressed through the operators instead.
  */
-template <is_BigInt_like TLHS, is_BigInt_like TRHS, bool ignore_quotient, bool ignore_remainder>
-BIGINT_TRACY_CONSTEXPR_AUTO
-_divide_loop(const TLHS& a, const TRHS& b, uint64_t e) -> DivModResult<BigInt> {
-	const auto na = a.size();
-	const auto nb = b.size();
-	const bool is_single_digit_division = nb == 1;
-	/* na >= nb holds. */
-	BigInt qt;
-	if constexpr (!ignore_quotient) {
-		/* quotient can have maximum (na-nb+1) digits */
-		qt.resize(na-nb+1);
+template <is_BigInt_like... Ts>
+class LinearCombination : IBigIntExpression {
+public:
+	explicit constexpr
+	LinearCombination(std::tuple<_private::ScaledTerm<Ts>...> terms)
+		: terms(std::move(terms))
+	{ }
+
+	/**
+	 * @brief result = the value of the combination. Reuses the storage of result, unless an operand other than a leading
+	 *        `lazy(result)` refers to it, in which case the value is computed in a temporary first.
+	 */
+	BIGINT_TRACY_CONSTEXPR_VOID
+	evaluate_to(BigInt &result) const {
+		BIGINT_TRACY_ZONE_SCOPED;
+		std::apply([&](const auto &first, const auto&... others) {
+			bool in_place = false;
+			bool aliased = std::is_constant_evaluated();
+			if (!aliased) {
+				const uint64_t *const digits = result.digits().data();
+				const auto capacity = result.capacity();
+				in_place = first.overlaps(digits, capacity);
+				if (in_place) { // scaling result where it is requires a factor * 2^shift which fits into a digit
+					const bool fits = (first.shift == 0) || (first.shift < 64 && (first.factor >> (64 - first.shift)) == 0);
+					in_place = (first.value.digits().data() == digits && first.value.size() == result.size() && fits);
+					aliased = !in_place;
+				}
+				aliased = aliased || (others.overlaps(digits, capacity) || ...);
+			}
+			if (aliased) {
+				BigInt tmp;
+				_private::evaluate_terms(tmp, false, first, others...);
+				result = std::move(tmp);
+				return;
+			}
+			_private::evaluate_terms(result, in_place, first, others...);
+		}, terms);
 	}
-	BigInt x;
-	_prefix(x, a, nb-1);
 
-	/* loop-invariant P: first m digits of ’a’ have been brought-down and processed. */
-	for(auto m = nb; m <= na; ++m) {
-		x.insert_front(a[na - m]);
+	std::tuple<_private::ScaledTerm<Ts>...> terms;
+};
 
-		const uint64_t yz_lo = x[nb-1];
-		const uint64_t yz_hi = x[nb];
+/**
+ * @brief starts a LinearCombination with `a`, see there.
+ */
+template <is_BigInt_like T> requires _private::has_contiguous_digits<T>
+CONSTEXPR_AUTO
+lazy(const T &a) -> LinearCombination<T> {
+	return LinearCombination<T>{std::tuple{_private::ScaledTerm<T>{a}}};
+}
+
+template <is_BigInt_like... Ts>
+CONSTEXPR_AUTO
+operator-(const LinearCombination<Ts...> &a) -> LinearCombination<Ts...> {
+	auto result = a;
+	std::apply([](auto&... term) { ((term.negate = !term.negate), ...); }, result.terms);
+	return result;
+}
+
+template <is_BigInt_like... Ts, is_BigInt_like... Us>
+CONSTEXPR_AUTO
+operator+(const LinearCombination<Ts...> &a, const LinearCombination<Us...> &b) -> LinearCombination<Ts..., Us...> {
+	return LinearCombination<Ts..., Us...>{std::tuple_cat(a.terms, b.terms)};
+}
+
+template <is_BigInt_like... Ts, is_BigInt_like... Us>
+CONSTEXPR_AUTO
+operator-(const LinearCombination<Ts...> &a, const LinearCombination<Us...> &b) -> LinearCombination<Ts..., Us...> {
+	return a + (-b);
+}
+
+template <is_BigInt_like... Ts, is_BigInt_like TRHS>
+CONSTEXPR_AUTO
+operator+(const LinearCombination<Ts...> &a, const TRHS &b) -> LinearCombination<Ts..., TRHS> {
+	return a + lazy(b);
+}
+
+template <is_BigInt_like TLHS, is_BigInt_like... Ts>
+CONSTEXPR_AUTO
+operator+(const TLHS &a, const LinearCombination<Ts...> &b) -> LinearCombination<TLHS, Ts...> {
+	return lazy(a) + b;
+}
+
+template <is_BigInt_like... Ts, is_BigInt_like TRHS>
+CONSTEXPR_AUTO
+operator-(const LinearCombination<Ts...> &a, const TRHS &b) -> LinearCombination<Ts..., TRHS> {
+	return a - lazy(b);
+}
+
+template <is_BigInt_like TLHS, is_BigInt_like... Ts>
+CONSTEXPR_AUTO
+operator-(const TLHS &a, const LinearCombination<Ts...> &b) -> LinearCombination<TLHS, Ts...> {
+	return lazy(a) - b;
+}
+
+template <is_BigInt_like... Ts, std::integral TRHS>
+CONSTEXPR_AUTO
+operator*(const LinearCombination<Ts...> &a, TRHS b) -> LinearCombination<Ts...> {
+	auto result = a;
+	const uint64_t factor = utils::constexpr_abs(b);
+	std::apply([&](auto&... term) {
+		auto scale = [&](auto &term) {
+			uint64_t high = 0;
+			term.factor = utils::mult_u128(term.factor, factor, high);
+			if (high != 0) {
+				auto msg = utils::concat(
+					"factor too large, it must fit into 64 bits.",
+					" factor: ", factor, ".");
+				throw std::invalid_argument(utils::error_msg(std::move(msg)));
+			}
+			term.negate = (term.negate != (b < 0));
+		};
+		(scale(term), ...);
+	}, result.terms);
+	return result;
+}
+
+template <std::integral TLHS, is_BigInt_like... Ts>
+CONSTEXPR_AUTO
+operator*(TLHS a, const LinearCombination<Ts...> &b) -> LinearCombination<Ts...> {
+	return b * a;
+}
+
+template <is_BigInt_like... Ts>
+CONSTEXPR_AUTO
+operator<<(const LinearCombination<Ts...> &a, uint64_t bits) -> LinearCombination<Ts...> {
+	auto result = a;
+	std::apply([&](auto&... term) { ((term.shift += bits), ...); }, result.terms);
+	return result;
+}
+
+}
+
+
+// tuning:
+#ifndef BIGINT_KARATSUBA_THRESHOLD
+#	define BIGINT_KARATSUBA_THRESHOLD 96
+#endif
+#ifndef BIGINT_TOOM3_THRESHOLD
+#	define BIGINT_TOOM3_THRESHOLD 192
+#endif
+#ifndef BIGINT_TOOM4_THRESHOLD
+#	define BIGINT_TOOM4_THRESHOLD 384
+#endif
+#ifndef BIGINT_NTT_THRESHOLD
+#	define BIGINT_NTT_THRESHOLD 1536
+#endif
+#ifndef BIGINT_THREADS
+#	define BIGINT_THREADS 1
+#endif
+#ifndef BIGINT_PARALLEL_THRESHOLD
+#	define BIGINT_PARALLEL_THRESHOLD 4096
+#endif
+#ifndef BIGINT_BURNIKEL_ZIEGLER_THRESHOLD
+#	define BIGINT_BURNIKEL_ZIEGLER_THRESHOLD 160
+#endif
+#ifndef BIGINT_NEWTON_THRESHOLD
+#	define BIGINT_NEWTON_THRESHOLD 65536
+#endif
+#ifndef BIGINT_MONTGOMERY_THRESHOLD
+#	define BIGINT_MONTGOMERY_THRESHOLD 384
+#endif
+#ifndef BIGINT_FIXED_UNROLL_LIMIT // compile time only: up to how many digits FixedBigInt fully unrolls its arithmetic
+#	define BIGINT_FIXED_UNROLL_LIMIT 8
+#endif
+
+namespace bigint {
+
+/**
+ * @brief Thresholds (in digits of base 2^64) at which the arithmetic switches between algorithms.
+ *        The defaults can be set at compile time using the BIGINT_*_THRESHOLD macros.
+ *        At runtime they can be changed through `bigint::tuning`. Constant evaluation always uses the defaults.
+ */
+struct Tuning {
+	/// smallest operand size for which mult() uses Karatsuba instead of schoolbook multiplication. Must be at least 2.
+	std::size_t karatsuba_threshold = BIGINT_KARATSUBA_THRESHOLD;
+	/// smallest operand size for which mult() uses Toom-Cook 3-way multiplication instead of Karatsuba.
+	std::size_t toom3_threshold = BIGINT_TOOM3_THRESHOLD;
+	/// smallest operand size for which mult() uses Toom-Cook 4-way multiplication instead of Toom-Cook 3-way.
+	std::size_t toom4_threshold = BIGINT_TOOM4_THRESHOLD;
+	/// smallest operand size for which mult() uses number theoretic transforms instead of Toom-Cook 4-way.
+	std::size_t ntt_threshold = BIGINT_NTT_THRESHOLD;
+	/// maximum number of threads a multiplication may use, including the calling thread. 0 and 1 disable parallel execution.
+	std::size_t threads = BIGINT_THREADS;
+	/// smallest operand size for which the independent sub-products of a multiplication are calculated in parallel.
+	std::size_t parallel_threshold = BIGINT_PARALLEL_THRESHOLD;
+	/// smallest divisor size, and quotient size, for which division uses Burnikel and Ziegler's recursive division instead of Knuth's Algorithm D.
+	std::size_t burnikel_ziegler_threshold = BIGINT_BURNIKEL_ZIEGLER_THRESHOLD;
+	/// smallest divisor size, and quotient size, for which division multiplies by a reciprocal computed by Newton's iteration instead.
+	std::size_t newton_threshold = BIGINT_NEWTON_THRESHOLD;
+	/// smallest odd modulus size for which pow_mod() uses Barrett reduction instead of Montgomery multiplication.
+	std::size_t montgomery_threshold = BIGINT_MONTGOMERY_THRESHOLD;
+};
+
+/**
+ * The thresholds used by all arithmetic operations at runtime. Not synchronized, so only change it while no other thread is calculating.
+ */
+inline Tuning tuning{};
+
+namespace _private {
+
+CONSTEXPR_AUTO
+current_tuning() -> Tuning {
+	if (std::is_constant_evaluated()) {
+		return Tuning{};
+	} else {
+		return tuning;
+	}
+}
+
+}
+
+}
+
+
+// parallel execution:
+namespace bigint::_private {
+
+/// the number of threads started by parallel_invoke() and parallel_for() that have not finished yet.
+inline std::atomic<std::size_t> parallel_workers{0};
+
+/**
+ * @brief whether the sub-products of a multiplication with operands of `size` digits should be calculated in parallel.
+ */
+CONSTEXPR_AUTO
+use_parallel(std::size_t size) -> bool {
+	if (std::is_constant_evaluated()) {
+		return false;
+	}
+	const auto tuning = current_tuning();
+	return tuning.threads > 1 && size >= tuning.parallel_threshold && current_memory_resource == nullptr;
+}
+
+/**
+ * @brief runs `task` on a new thread if the thread budget of `tuning.threads` allows it.
+ * @return the future of the started thread, or an invalid future if no thread was started.
+ */
+template <typename F>
+auto
+_try_start_worker(const F &task) -> std::future<void> {
+	const auto tuning = current_tuning(); // not an integral constant, whose initializer would always be constant evaluated
+	const auto max_workers = std::max(tuning.threads, std::size_t{1}) - 1;
+	auto workers = parallel_workers.load();
+	do {
+		if (workers >= max_workers) {
+			return {};
+		}
+	} while (!parallel_workers.compare_exchange_weak(workers, workers + 1));
+
+	try {
+		return std::async(std::launch::async, [&task]() {
+			struct Release {
+				~Release() { parallel_workers.fetch_sub(1); }
+			} release;
+			task();
+		});
+	} catch (const std::system_error &) {
+		// no thread could be started. the work runs on the calling thread, as if the budget was used up.
+		parallel_workers.fetch_sub(1);
+		return {};
+	}
+}
+
+/**
+ * @brief calls task(i) for all i < count, distributed over the calling thread and as many new threads as the budget allows.
+ */
+template <typename F>
+auto
+_parallel_for_threads(std::size_t count, const F &task) -> void {
+	std::atomic<std::size_t> next{0};
+	const auto work = [&]() {
+		for (auto i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+			task(i);
+		}
+	};
+	std::vector<std::future<void>> workers;
+	for (std::size_t i = 1; i < count; ++i) {
+		auto worker = _try_start_worker(work);
+		if (!worker.valid()) {
+			break;
+		}
+		workers.push_back(std::move(worker));
+	}
+	work();
+	for (auto& worker : workers) {
+		worker.get(); // rethrows exceptions of the worker
+	}
+}
+
+/**
+ * @brief calls task(i) for all i < count. If use_parallel(size), the calls are distributed over the available threads,
+ *        otherwise they are made in order on the calling thread.
+ */
+template <typename F>
+BIGINT_TRACY_CONSTEXPR_VOID
+parallel_for(std::size_t size, std::size_t count, const F &task) {
+	if (use_parallel(size)) {
+		_parallel_for_threads(count, task);
+	} else {
+		for (std::size_t i = 0; i < count; ++i) {
+			task(i);
+		}
+	}
+}
+
+/**
+ * @brief calls all tasks, in parallel if use_parallel(size).
+ * @return the results of the tasks, in order.
+ */
+template <typename... F>
+BIGINT_TRACY_CONSTEXPR_AUTO
+parallel_invoke(std::size_t size, const F&... tasks) {
+	using T = std::common_type_t<std::invoke_result_t<const F&>...>;
+	if (!use_parallel(size)) {
+		return std::array<T, sizeof...(F)>{ tasks()... };
+	}
+
+	std::array<T, sizeof...(F)> results;
+	_parallel_for_threads(sizeof...(F), [&](std::size_t index) {
+		std::size_t i = 0;
+		((i++ == index ? (results[index] = tasks(), 0) : 0), ...);
+	});
+	return results;
+}
+
+}
+
+
+// sign handing for multiplication & division:
+namespace bigint::_private {
+
+CONSTEXPR_AUTO
+mult_sign(Sign a, Sign b) -> Sign {
+	return a != b ? Sign::NEG : Sign::POS;
+}
+
+}
+
+// multiplication:
+namespace bigint {
+
+BIGINT_TRACY_CONSTEXPR_AUTO
+mult(uint64_t a, uint64_t b) -> BigIntAdapter2 {
+	BIGINT_TRACY_ZONE_SCOPED;
+	uint64_t high;
+	const uint64_t low = utils::mult_u128(a, b, high);
+	return BigIntAdapter2{low, high};
+}
+
+template <is_BigInt_like TRES, is_BigInt_like TLHS>
+BIGINT_TRACY_CONSTEXPR_VOID
+mult(TRES &result, TLHS &a, uint64_t b) {
+	BIGINT_TRACY_ZONE_SCOPED;
+	if (b == 0 || is_zero(a)) {
+		result = BigInt{};
+		return;
+	}
+	result.resize(a.size());
+
+	uint64_t c = 0; // carry
+	if constexpr (_private::has_mutable_contiguous_digits<TRES> && _private::has_contiguous_digits<TLHS>) {
+		c = kernels::mul_1(result.digits().data(), a.digits().data(), a.size(), b);
+	} else {
+		for (auto i = 0ull; i < a.size(); i++) {
+			const auto rc = mult(a[i], b);
+			result.set(i, rc[0] + c);
+			c = rc[1] + (result[i] < c ? 1 : 0); // account for addition overflow
+		}
+	}
+	if (c){
+		result.append(c);
+	};
+	result.sign() = a.sign();
+	result.cleanup();
+}
+
+template <is_BigInt_like TRES, is_BigInt_like TLHS>
+BIGINT_TRACY_CONSTEXPR_VOID
+mult(TRES &result, TLHS &a, int64_t b) {
+	mult(result, a, (uint64_t)llabs(b));
+	if (b < 0) {
+		result.sign() = _private::neg(result.sign());
+	}
+}
+
+}
+
+
+// row kernels:
+namespace bigint::_private {
+
+/**
+ * @brief result[offset + i] += a[i] for i < n, propagating the carry from digit to digit.
+ * @return the carry out of result[offset + n - 1]
+ */
+template <is_BigInt_like TRES, is_BigInt_like TLHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+add_n(TRES &result, std::size_t offset, const TLHS &a, std::size_t n) -> uint64_t {
+	if constexpr (has_mutable_contiguous_digits<TRES> && has_contiguous_digits<TLHS>) {
+		if (n <= a.size() && offset + n <= result.size()) {
+			uint64_t *const r = result.digits().data() + offset;
+			return kernels::add_n(r, r, a.digits().data(), n);
+		}
+	}
+	uint8_t c = 0; // carry
+	for (std::size_t i = 0; i < n; ++i) {
+		result.set(offset + i, utils::add_carry(result[offset + i], a[i], c));
+	}
+	return c;
+}
+
+/**
+ * @brief result[offset + i] += a[i] * b for i < n in a single pass over result.
+ * @return the carry out of result[offset + n - 1], a full digit
+ */
+template <is_BigInt_like TRES, is_BigInt_like TLHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+addmul_1(TRES &result, std::size_t offset, const TLHS &a, std::size_t n, uint64_t b) -> uint64_t {
+	if constexpr (has_mutable_contiguous_digits<TRES> && has_contiguous_digits<TLHS>) {
+		if (n <= a.size() && offset + n <= result.size()) {
+			return kernels::addmul_1(result.digits().data() + offset, a.digits().data(), n, b);
+		}
+	}
+	uint64_t c = 0; // carry
+	for (std::size_t i = 0; i < n; ++i) {
+		uint64_t hi;
+		const auto lo = utils::mult_u128(a[i], b, hi);
+		uint8_t k = 0;
+		const auto lo_c = utils::add_carry(lo, c, k);
+		hi += k;
+		k = 0;
+		result.set(offset + i, utils::add_carry(result[offset + i], lo_c, k));
+		c = hi + k; // a[i] * b + result[i] + c < 2^128, so this never overflows.
+	}
+	return c;
+}
+
+/**
+ * @brief result[offset + i] -= a[i] * b for i < n in a single pass over result.
+ * @return the borrow out of result[offset + n - 1], a full digit
+ */
+template <is_BigInt_like TRES, is_BigInt_like TLHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+submul_1(TRES &result, std::size_t offset, const TLHS &a, std::size_t n, uint64_t b) -> uint64_t {
+	if constexpr (has_mutable_contiguous_digits<TRES> && has_contiguous_digits<TLHS>) {
+		if (n <= a.size() && offset + n <= result.size()) {
+			return kernels::submul_1(result.digits().data() + offset, a.digits().data(), n, b);
+		}
+	}
+	uint64_t c = 0; // borrow
+	for (std::size_t i = 0; i < n; ++i) {
+		uint64_t hi;
+		const auto lo = utils::mult_u128(a[i], b, hi);
+		uint8_t k = 0;
+		const auto lo_c = utils::add_carry(lo, c, k);
+		hi += k;
+		k = 0;
+		result.set(offset + i, utils::sub_borrow(result[offset + i], lo_c, k));
+		c = hi + k;
+	}
+	return c;
+}
+
+}
+
+
+// multiplication ignoring sign:
+namespace bigint::_private {
+
+// forward declaration:
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+mult_ignore_sign(const TLHS &a, const TRHS &b) -> BigInt;
+
+template <is_BigInt_like T>
+BIGINT_TRACY_CONSTEXPR_AUTO
+square_ignore_sign(const T &a) -> BigInt;
+
+}
+
+
+// multiplication:
+namespace bigint {
+
+/**
+ * @brief a * a, using about half the digit multiplications of mult(a, a).
+ */
+template <is_BigInt_like T>
+BIGINT_TRACY_CONSTEXPR_AUTO
+square(const T &a) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	if (is_zero(a)) {
+		return BigInt{};
+	}
+	return _private::square_ignore_sign(a);
+}
+
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+mult(const TLHS &a, const TRHS &b) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	if constexpr (std::is_same_v<TLHS, TRHS>) {
+		if (&a == &b) {
+			return square(a);
+		}
+	}
+	if (is_zero(a) || is_zero(b)) {
+		return BigInt{};
+	}
+	BigInt result = _private::mult_ignore_sign(a, b);
+	result.sign() = _private::mult_sign(a.sign(), b.sign());
+	return result;
+}
+
+template <is_BigInt_like TLHS, std::integral TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator*(const TLHS &a, TRHS b) -> BigInt {
+	using TRHS2 = std::conditional_t<std::is_unsigned_v<TRHS>, uint64_t, int64_t>;
+	BigInt result;
+	mult(result, const_cast<TLHS&>(a), (TRHS2)b);
+	return result;
+}
+
+template <std::integral TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator*(TLHS a, const TRHS &b) -> BigInt {
+	return b * a;
+}
+
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator*(const TLHS &a, const TRHS &b) -> BigInt {
+	return mult(a, b);
+}
+
+template <is_BigInt_like TLHS, std::integral TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO_DISCARD
+operator*=(TLHS &a, TRHS b) -> TLHS& {
+	using TRHS2 = std::conditional_t<std::is_unsigned_v<TRHS>, uint64_t, int64_t>;
+	mult(a, a, (TRHS2)b);
+	return a;
+}
+
+template <std::integral TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator*(BigInt &&a, TRHS b) -> BigInt {
+	a *= b;
+	return std::move(a);
+}
+
+template <std::integral TLHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator*(TLHS a, BigInt &&b) -> BigInt {
+	b *= a;
+	return std::move(b);
+}
+
+template <is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO_DISCARD
+operator*=(BigInt &a, const TRHS &b) -> BigInt& {
+	a = std::move(mult(a, b));
+	return a;
+}
+
+}
+
+
+// DivModResult:
+namespace bigint {
+
+template<class D, class R=D>
+struct DivModResult {
+	typedef D _D;
+	typedef R _R;
+	D d; R r;
+};
+
+}
+
+
+// divmod ignoring sign:
+namespace bigint::_private {
+
+/**
+ * @brief copies the digits of `from` into `to`, which has at least from.size() digits, shifted left by 0 <= shift < 64 bits.
+ * @return the bits shifted out of the most significant digit
+ */
+template <is_BigInt_like T>
+BIGINT_TRACY_CONSTEXPR_AUTO
+_shifted_copy(BigInt &to, const T &from, unsigned shift) -> uint64_t {
+	const std::size_t n = from.size();
+	uint64_t *const digits = to.digits().data();
+	if constexpr (has_contiguous_digits<T>) {
+		if (shift != 0) {
+			return kernels::lshift(digits, from.digits().data(), n, shift);
+		}
+		std::copy_n(from.digits().data(), n, digits);
+		return 0;
+	} else {
+		for (std::size_t i = 0; i < n; ++i) {
+			digits[i] = from[i];
+		}
+		return (shift != 0) ? kernels::lshift(digits, digits, n, shift) : 0;
+	}
+}
+
+/**
+ * @brief Knuth's Algorithm D (The Art of Computer Programming, vol. 2, 4.3.1) on normalized digits:
+ *        divides the m + n + 1 digits of u by the n >= 2 digits of v, whose top bit is set, and u[m + n] < v[n - 1].
+ *        u is overwritten with the remainder in its n low digits, q receives the m + 1 quotient digits.
+ *        Each quotient digit is estimated from the top three digits of u and the top two of v, which is at most one too large,
+ *        then the fused submul_1 subtracts its multiple of v, and v is added back in the rare case it was.
+ */
+template <bool ignore_quotient>
+BIGINT_TRACY_CONSTEXPR_VOID
+_knuth_divide(uint64_t *q, uint64_t *u, std::size_t m, const uint64_t *v, std::size_t n) {
+	const uint64_t v1 = v[n - 1];
+	const uint64_t v0 = v[n - 2];
+	for (std::size_t j = m + 1; j-- > 0;) {
+		uint64_t *const uj = u + j;
+		const uint64_t u2 = uj[n];
+		const uint64_t u1 = uj[n - 1];
+		const uint64_t u0 = uj[n - 2];
+
+		// qhat = (u2 u1) / v1 and rhat = (u2 u1) % v1, where u2 <= v1.
+		uint64_t qhat;
+		uint64_t rhat;
+		uint8_t rhat_overflow = 0;
+		if (u2 == v1) {
+			qhat = ~uint64_t{0};
+			rhat = utils::add_carry(u1, v1, rhat_overflow);
+		} else {
+			qhat = utils::div_u128_saturate(u2, u1, v1);
+			rhat = u1 - qhat * v1;
+		}
+		// while qhat * v0 > (rhat u0), qhat is too large.
+		while (!rhat_overflow) {
+			uint64_t high;
+			const uint64_t low = utils::mult_u128(qhat, v0, high);
+			if (high < rhat || (high == rhat && low <= u0)) {
+				break;
+			}
+			--qhat;
+			rhat = utils::add_carry(rhat, v1, rhat_overflow);
+		}
+
+		const uint64_t borrow = kernels::submul_1(uj, v, n, qhat);
+		const bool negative = uj[n] < borrow;
+		uj[n] -= borrow;
+		if (negative) {
+			--qhat;
+			uj[n] += kernels::add_n(uj, uj, v, n);
+		}
+		if constexpr (!ignore_quotient) {
+			q[j] = qhat;
+		}
+	}
+}
+
+
+/**
+ * @brief |aa| / v and |aa| % v by Knuth's Algorithm D, where the divisor v of nb >= 2 digits has already been shifted left by `shift` bits,
+ *        so that its top bit is set, and aa.size() >= nb. Apart from the quotient only a single buffer holding the (shifted) remainder is allocated.
+ */
+template <is_BigInt_like TLHS, bool ignore_quotient, bool ignore_remainder>
+BIGINT_TRACY_CONSTEXPR_AUTO
+_divmod_knuth_normalized(const TLHS& aa, const BigInt& v, unsigned shift) -> DivModResult<BigInt> {
+	const std::size_t na = aa.size();
+	const std::size_t nb = v.size();
+	BigInt q;
+	if constexpr (!ignore_quotient) {
+		q.resize(na - nb + 1);
+	}
+	BigInt u;
+	u.resize(na + 1);
+	u.digits()[na] = _shifted_copy(u, aa, shift);
+
+	_knuth_divide<ignore_quotient>(q.digits().data(), u.digits().data(), na - nb, v.digits().data(), nb);
+
+	u.resize(nb);
+	if constexpr (!ignore_remainder) {
+		if (shift != 0) {
+			static_cast<void>(kernels::rshift(u.digits().data(), u.digits().data(), nb, shift));
+		}
+	} // otherwise the shifted remainder is just as good to tell whether it is zero.
+	u.cleanup();
+	q.cleanup();
+	return {std::move(q), std::move(u)};
+}
+
+/**
+ * @brief |aa| / |bb| and |aa| % |bb| for aa.size() >= bb.size() and bb != 0. A single digit divisor is handled digit by digit,
+ *        larger ones by Knuth's Algorithm D, normalized by a bit shift.
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS, bool ignore_quotient, bool ignore_remainder>
+BIGINT_TRACY_CONSTEXPR_AUTO
+_divmod_knuth(const TLHS& aa, const TRHS& bb) -> DivModResult<BigInt> {
+	const std::size_t na = aa.size();
+	const std::size_t nb = bb.size();
+	if (nb == 1) {
+		BigInt q;
+		if constexpr (!ignore_quotient) {
+			q.resize(na);
+		}
+		const uint64_t v = bb[0];
+		uint64_t r = 0;
+		for (std::size_t i = na; i-- > 0;) {
+			const uint64_t u = aa[i];
+			const uint64_t d = utils::div_u128_saturate(r, u, v); // r < v, so d fits
+			r = u - d * v;
+			if constexpr (!ignore_quotient) {
+				q.digits()[i] = d;
+			}
+		}
+		q.cleanup();
+		return {std::move(q), BigInt{r}};
+	}
+
+	// normalization: shift the divisor left until its top bit is set. The dividend is shifted along with it.
+	const auto shift = unsigned(std::countl_zero(bb[nb - 1]));
+	BigInt v;
+	v.resize(nb);
+	static_cast<void>(_shifted_copy(v, bb, shift));
+	return _divmod_knuth_normalized<TLHS, ignore_quotient, ignore_remainder>(aa, v, shift);
+}
+
+// forward declaration:
+BIGINT_TRACY_CONSTEXPR_AUTO
+_bz_div_2n_1n(const BigInt& a, const BigInt& b, std::size_t n, std::size_t threshold) -> DivModResult<BigInt>;
+
+/**
+ * @brief the step of Burnikel and Ziegler's recursive division dividing 3 by 2 blocks of h digits: a / b and a % b,
+ *        where b has 2h digits and its top bit set, and a < b * 2^(64 h).
+ *        The quotient is estimated from the top blocks by a 2 by 1 block division, and corrected at most twice.
+ */
+BIGINT_TRACY_CONSTEXPR_AUTO
+_bz_div_3n_2n(const BigInt& a, const BigInt& b, std::size_t h, std::size_t threshold) -> DivModResult<BigInt> {
+	const auto b1 = sliced(b, h, h);
+	const BigInt a12{sliced(a, h, 2 * h)};
+	BigInt q;
+	BigInt r;
+	if (sliced(a, 2 * h, h) < b1) {
+		auto [q_, r_] = _bz_div_2n_1n(a12, BigInt{b1}, h, threshold);
+		q = std::move(q_);
+		r = std::move(r_);
+	} else {
+		// the top block of a equals b1, so the quotient is 2^(64 h) - 1.
+		q.resize(h);
+		std::fill(q.digits().begin(), q.digits().end(), ~uint64_t{0});
+		r = a12 - lshifted(b1, h) + b1;
+	}
+	r = BigInt{lshifted(std::move(r), h)} + sliced(a, 0, h) - mult(q, sliced(b, 0, h));
+	while (is_neg(r)) {
+		q -= 1;
+		r += b;
+	}
+	return {std::move(q), std::move(r)};
+}
+
+/**
+ * @brief the step of Burnikel and Ziegler's recursive division dividing 2 by 1 blocks of n digits: a / b and a % b,
+ *        where b has n digits and its top bit set, and a < b * 2^(64 n). Small or odd n, and short quotients, are left to Algorithm D.
+ */
+BIGINT_TRACY_CONSTEXPR_AUTO
+_bz_div_2n_1n(const BigInt& a, const BigInt& b, std::size_t n, std::size_t threshold) -> DivModResult<BigInt> {
+	if (is_zero(a) || a.size() < b.size()) {
+		return {BigInt{0}, a};
+	}
+	if (n % 2 != 0 || n < threshold || a.size() - b.size() < threshold) { // a short quotient is cheap with Algorithm D as well
+		return _divmod_knuth<BigInt, BigInt, false, false>(a, b);
+	}
+	const std::size_t h = n / 2;
+	auto [q1, r1] = _bz_div_3n_2n(BigInt{sliced(a, h, 3 * h)}, b, h, threshold);
+	auto [q2, r] = _bz_div_3n_2n(BigInt{lshifted(std::move(r1), h)} + sliced(a, 0, h), b, h, threshold);
+	return {BigInt{lshifted(std::move(q1), h)} + q2, std::move(r)};
+}
+
+/**
+ * @brief Burnikel and Ziegler, 1998, Fast Recursive Division: |aa| / |bb| and |aa| % |bb| in O(M(n) log n) for a divisor of n digits,
+ *        where M(n) is the cost of a multiplication. The divisor is padded to n = j * 2^k digits with j < threshold and normalized,
+ *        then the dividend is divided block by block of n digits, each 2 by 1 block division recursing on halves.
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+_divmod_burnikel_ziegler(const TLHS& aa, const TRHS& bb, std::size_t threshold) -> DivModResult<BigInt> {
+	BIGINT_TRACY_ZONE_SCOPED;
+	const std::size_t nb = bb.size();
+	std::size_t k = 0;
+	while ((nb >> k) >= threshold) {
+		++k;
+	}
+	const std::size_t n = ((nb + (std::size_t{1} << k) - 1) >> k) << k;
+	const uint64_t shift = 64 * (n - nb) + std::countl_zero(bb[nb - 1]);
+	const BigInt b{BigInt{abs(bb)} << shift};
+	const BigInt a{BigInt{abs(aa)} << shift};
+
+	// a is split into t blocks of n digits, so that the top block is less than 2^(64 n - 1) <= b.
+	const std::size_t a_bits = 64 * a.size() - std::countl_zero(a[a.size() - 1]);
+	const std::size_t t = std::max<std::size_t>(2, a_bits / (64 * n) + 1);
+
+	BigInt q;
+	q.resize((t - 1) * n);
+	BigInt z{sliced(a, (t - 2) * n, 2 * n)};
+	for (std::size_t i = t - 1; i-- > 0;) {
+		auto [qi, r] = _bz_div_2n_1n(z, b, n, threshold);
+		std::copy(qi.digits().begin(), qi.digits().end(), q.digits().begin() + i * n);
+		z = (i > 0) ? BigInt{lshifted(std::move(r), n)} + sliced(a, (i - 1) * n, n) : std::move(r);
+	}
+	q.cleanup();
+	return {std::move(q), z >> shift};
+}
+
+/**
+ * @brief floor(2^(64 k) / d) for d > 0, give or take a few units, by Newton's iteration x' = x + x (2^(64 k) - d x) / 2^(64 k).
+ *        A step doubles the number of correct digits, so a single one refines the reciprocal of the top half of d, computed recursively.
+ *        Only the digits of d and of the error that can change the result by more than a unit are multiplied,
+ *        so m digits cost about three multiplications of m digits. Short results are divided directly by Algorithm D.
+ */
+template <is_BigInt_like T>
+BIGINT_TRACY_CONSTEXPR_AUTO
+_approx_reciprocal(const T& d, std::size_t k, std::size_t threshold) -> BigInt {
+	const std::size_t n = d.size();
+	if (k < n + std::max<std::size_t>(threshold, 8)) { // the recursion needs m >= 5
+		if (k + 1 < n) {
+			return BigInt{0};
+		}
+		BigInt power;
+		power.resize(k + 1);
+		power.digits()[k] = 1;
+		return _divmod_knuth<BigInt, T, false, true>(power, d).d;
+	}
+	const std::size_t m = k - n; // the result has about m + 1 digits.
+	const std::size_t h = m / 2 + 2; // correct digits of the first approximation, two more than half, so that the step squares away their error.
+	const std::size_t s = n - std::min(n, h + 1);
+	const auto d_hi = sliced(d, s, n - s);
+	const BigInt x0 = _approx_reciprocal(d_hi, d_hi.size() + h, threshold); // x = x0 * 2^(64 (m - h))
+
+	// the error e = 2^(64 k) - d x, without the low digits of d and of e, which change the correction by less than a unit.
+	const std::size_t low = (n > m + 3) ? n - m - 3 : 0;
+	const std::size_t t = low + m - h; // e = (2^(64 (k - t)) - d_lo x0) * 2^(64 t)
+	const std::size_t u = (n > t + 2) ? n - 2 - t : 0;
+	const BigInt e = (BigInt{1} << 64 * (k - t)) - mult(sliced(d, low, n - low), x0);
+	const BigInt xe = mult(x0, sliced(e, u, e.size()));
+	const BigInt correction{sliced(xe, (k - m) + h - t - u, xe.size())};
+
+	BigInt x{lshifted(x0, m - h)};
+	if (is_neg(e)) {
+		x -= correction;
+	} else {
+		x += correction;
+	}
+	return x;
+}
+
+/**
+ * @brief floor(2^(64 k) / d) and 2^(64 k) % d for d > 0: the Newton approximation, corrected by its remainder.
+ */
+template <is_BigInt_like T>
+BIGINT_TRACY_CONSTEXPR_AUTO
+_reciprocal(const T& d, std::size_t k, std::size_t threshold) -> DivModResult<BigInt> {
+	BigInt x = _approx_reciprocal(d, k, threshold);
+	BigInt r = (BigInt{1} << 64 * k) - mult(d, x);
+	while (is_neg(r)) {
+		x -= 1;
+		r += d;
+	}
+	while (r >= d) {
+		x += 1;
+		r -= d;
+	}
+	return {std::move(x), std::move(r)};
+}
+
+/**
+ * @brief a * x for a reciprocal x of m + 1 digits, whose top digit is small. Multiplying by that digit separately
+ *        keeps the product of the rest within the transform length of a product of m digits.
+ */
+template <is_BigInt_like TLHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+_mult_reciprocal(const TLHS& a, const BigInt& x, std::size_t m) -> BigInt {
+	if (m == 0 || x.size() != m + 1) {
+		return mult(a, x);
+	}
+	return mult(a, sliced(x, 0, m)) + lshifted(a * x[m], m);
+}
+
+/**
+ * @brief |aa| / |bb| and |aa| % |bb| for aa.size() >= bb.size() and bb != 0, by multiplying with the Newton reciprocal of |bb|.
+ *        Only the top digits of |aa| take part in estimating the quotient, which is off by a few units at most
+ *        and corrected by the remainder. That costs a small multiple of a multiplication, independent of the size of the operands.
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+_divmod_newton(const TLHS& aa, const TRHS& bb, std::size_t threshold) -> DivModResult<BigInt> {
+	BIGINT_TRACY_ZONE_SCOPED;
+	const std::size_t na = aa.size();
+	const std::size_t nb = bb.size();
+	const auto a = sliced(aa, 0, na);
+	const auto b = sliced(bb, 0, nb);
+
+	// a / b = a x / 2^(64 na) for x = 2^(64 na) / b. The low nb - 1 digits of a contribute less than one, as does the error of x.
+	const BigInt x = _approx_reciprocal(b, na, threshold);
+	const BigInt ax = _mult_reciprocal(sliced(a, nb - 1, na), x, na - nb);
+	BigInt q{sliced(ax, na - nb + 1, ax.size())};
+	BigInt r = a - mult(q, b);
+	while (is_neg(r)) {
+		q -= 1;
+		r += b;
+	}
+	while (r >= b) {
+		q += 1;
+		r -= b;
+	}
+	return {std::move(q), std::move(r)};
+}
+
+
+/**
+ * @brief |aa| / |bb| and |aa| % |bb|. Large divisions with large quotients are done by Burnikel and Ziegler's recursive division,
+ *        which makes them scale with multiplication, huge ones by multiplying with a Newton reciprocal, smaller ones by Knuth's Algorithm D.
+ *
+ * @param aa the dividend
+ * @param bb the divisor
+ * @return the result
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS, bool ignore_quotient = false, bool ignore_remainder = false>
+BIGINT_TRACY_CONSTEXPR_AUTO
+divmod_ignore_sign(const TLHS& aa, const TRHS& bb) -> DivModResult<BigInt> {
+	BIGINT_TRACY_ZONE_SCOPED;
+
+	if (is_zero(bb)) {
+		throw std::domain_error{utils::error_msg("division by zero")};
+	}
+	if (is_zero(aa)) {
+		return {BigInt{0}, BigInt{0}};
+	}
+	if (bb.size() > aa.size()) {
+		if constexpr (!ignore_remainder) {
+			return {BigInt{0}, BigInt{aa}};
+		} else {
+			return {BigInt{0}, BigInt{1}}; // remainder could be any positive number. it is only used to signify that the remiander is non-zero.
+		}
+	}
+
+	const auto tuning = current_tuning(); // not an integral constant, whose initializer would always be constant evaluated
+	if (bb.size() >= tuning.newton_threshold && aa.size() - bb.size() >= tuning.newton_threshold) {
+		return _divmod_newton(aa, bb, tuning.burnikel_ziegler_threshold);
+	}
+	if (bb.size() >= tuning.burnikel_ziegler_threshold && aa.size() - bb.size() >= tuning.burnikel_ziegler_threshold) {
+		return _divmod_burnikel_ziegler(aa, bb, tuning.burnikel_ziegler_threshold);
+	}
+	return _divmod_knuth<TLHS, TRHS, ignore_quotient, ignore_remainder>(aa, bb);
+}
+
+
+template <is_BigInt_like TLHS, bool ignore_quotient = false, bool ignore_remainder = false>
+BIGINT_TRACY_CONSTEXPR_AUTO
+divmod_ignore_sign(const TLHS &a, const uint64_t &b) -> DivModResult<BigInt, uint64_t> {
+	const auto res = divmod_ignore_sign<TLHS, BigIntAdapter<uint64_t>, ignore_quotient, ignore_remainder>(a, BigIntAdapter{b});
+	return { res.d, res.r[0] };
+}
+
+}
+
+
+// divmod:
+namespace bigint {
+
+template <is_BigInt_like TLHS, is_BigInt_like TRHS, bool ignore_quotient = false, bool ignore_remainder = false>
+BIGINT_TRACY_CONSTEXPR_AUTO
+divmod(const TLHS &a, const TRHS &b) -> DivModResult<BigInt> {
+	auto r = _private::divmod_ignore_sign<TLHS, TRHS, ignore_quotient, ignore_remainder>(a, b);
+
+	r.r.cleanup(); //r.r is also used by quotient.
+	if constexpr (!ignore_remainder) {
+		if (!is_zero(r.r)) {
+			if (is_neg(a)) {
+				r.r.sign() = Sign::NEG;
+			}
+			if (a.sign() != b.sign()) {
+				r.r += b;
+			}
+		}
+	}
+	if constexpr (!ignore_quotient) {
+		r.d.sign() = _private::mult_sign(a.sign(), b.sign());
+		if (!is_zero(r.r) and r.d.sign() == Sign::NEG) {
+			r.d -= 1;
+		}
+		r.d.cleanup();
+	}
+	return r;
+}
+
+template <is_BigInt_like TLHS, bool ignore_quotient = false, bool ignore_remainder = false>
+BIGINT_TRACY_CONSTEXPR_AUTO
+divmod(const TLHS &a, int64_t b) -> DivModResult<BigInt, int64_t> {
+	const auto res = divmod<TLHS, BigIntAdapter<int64_t>, ignore_quotient, ignore_remainder>(a, BigIntAdapter{b});
+
+	if constexpr (ignore_remainder) {
+		return { res.d, 0 };
+	} else {
+		int64_t r = (int64_t)res.r[0];
+		if (is_neg(res.r)) {
+			r = -r;
+		}
+		return { res.d, r };
+	}
+}
+
+template <is_BigInt_like TLHS, bool ignore_quotient = false, bool ignore_remainder = false>
+BIGINT_TRACY_CONSTEXPR_AUTO
+divmod(const TLHS &a, uint64_t b) -> DivModResult<BigInt, uint64_t> {
+	const auto res = divmod<TLHS, BigIntAdapter<uint64_t>, ignore_quotient, ignore_remainder>(a, BigIntAdapter{b});
+	return { res.d, res.r[0] };
+}
+
+template <is_BigInt_like TLHS, bool ignore_quotient = false, bool ignore_remainder = false>
+BIGINT_TRACY_CONSTEXPR_AUTO
+divmod1(const TLHS &a, uint32_t b) -> DivModResult<BigInt, uint32_t> {
+	BIGINT_TRACY_ZONE_SCOPED;
+	if (b == 0) {
+		throw std::domain_error{utils::error_msg("division by zero")};
+	}
+	if (is_zero(a)) {
+		return {BigInt{0}, 0};
+	}
+
+	BigInt q;
+	if constexpr (!ignore_quotient) {
+		q.resize(a.size());
+	}
+
+	// y = q * b; but not always.
+	BigInt y{0, a.sign()};
+	if constexpr (!ignore_remainder) {
+		y.resize(a.size() + 1);
+	}
+
+	uint64_t c_div = 0ull;
+	uint64_t di_hi = 0ull;
+	uint64_t ai_lo = 0ull;
+
+	size_t i = a.size() + 1;
+	bool is_first_iter = true;
+	while (i > 0) {
+		--i;
+		uint64_t di = 0;
+		if (!is_first_iter) {
+			const auto di_lo = ai_lo / b;
+			c_div = (ai_lo % b) << 32; // ???
+			di = (di_hi << 32) | di_lo;
+
+			if constexpr (!ignore_quotient) {
+				q.set(i, di);
+			}
+		}
+
+		const auto ai = (i != 0) ? a[i-1]: 0;
+		const auto ai_hi = (i != 0) ? (ai >> 32) | c_div : 0;
+				   di_hi = ai_hi / b;
+		const auto c_diw = (ai_hi % b) << 32;
+				   ai_lo = (ai & 0xFFFFFFFFull) | c_diw;
+
+		if constexpr (!ignore_remainder) {
+			const uint32_t c_ = di_hi >> 32;
+			const auto ji = di + c_;
+			const auto yi = ji*b; // todo: investigate why doesn't this overflow ??
+			y.set(i, yi);
+		}
+
+		is_first_iter = false;
+	}
+
+
+	if constexpr (!ignore_quotient) {
+		q.sign() = _private::mult_sign(a.sign(), Sign::POS);
+		if (c_div != 0 && q.sign() == Sign::NEG) {
+			q -= 1;
+		}
+		q.cleanup();
+	}
+
+	if constexpr (ignore_remainder) {
+		return { q, 0 };
+	} else {
+		y.cleanup();
+		BigInt r_big = a - y;
+		uint32_t r = (uint32_t) r_big[0];
+		if (r != 0 && is_neg(a)) {
+			r = b - r;
+		}
+		return { q, r };
+	}
+}
+
+template <is_BigInt_like TLHS, bool ignore_quotient = false, bool ignore_remainder = false>
+BIGINT_TRACY_CONSTEXPR_AUTO
+divmod1(const TLHS &a, int32_t bb) -> DivModResult<BigInt, int32_t> {
+	if (bb < 0) {
+		auto r = divmod1<_private::BigIntNeg<const TLHS&>, ignore_quotient, ignore_remainder>(-a, (uint32_t) -bb);
+		return DivModResult{std::move(r.d), -(int32_t)r.r};
+	} else {
+		auto r = divmod1<TLHS, ignore_quotient, ignore_remainder>(a, (uint32_t) bb);
+		return DivModResult{std::move(r.d), (int32_t)r.r};
+	}
+}
+
+}
+
+
+// division:
+namespace bigint {
+
+template <is_BigInt_like TLHS>
+BIGINT_TRACY_CONSTEXPR_VOID
+div(BigInt &result, TLHS &a, uint32_t b) {
+	BIGINT_TRACY_ZONE_SCOPED;
+	if (b == 0) {
+		throw std::domain_error{utils::error_msg("division by zero")};
+	}
+	if (is_zero(a)) {
+		result = BigInt{0};
+	}
+	uint64_t c_lo = 0ull;
+	for (auto i = a.size(); i-->0;) {
+		const auto ai = a[i];
+		const auto ai_hi = (ai >> 32) | c_lo;
+		const auto r_hi = ai_hi / b;
+		const auto c_hi = (ai_hi % b) << 32;
+
+		const auto ai_lo = (ai & 0xFFFFFFFFull) | c_hi;
+		const auto r_lo = ai_lo / b;
+		c_lo = (ai_lo % b) << 32;
+		const auto r = (r_hi << 32) | r_lo;
+		result.set(i, r);
+	}
+	result.sign() = a.sign();
+	if (c_lo != 0 && result.sign() == Sign::NEG) {
+		result -= 1;
+	}
+}
+
+template <is_BigInt_like TLHS>
+BIGINT_TRACY_CONSTEXPR_VOID
+div(BigInt &result, TLHS &a, int32_t bb) {
+	if (bb < 0) {
+		auto neg_a = -a; // todo check undefined behavior with -a if result === a, because operator-() const-ifys a?
+		div(result, neg_a, (uint32_t) -bb);
+	} else {
+		div(result, a, (uint32_t) bb);
+	}
+}
+
+
+template <is_BigInt_like TLHS, one_of<uint32_t, int32_t> TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator/(const TLHS &a, TRHS b) -> BigInt {
+	BigInt result;
+	result.resize(a.size());
+	div(result, const_cast<TLHS&>(a), b);
+	result.cleanup();
+	return result;
+}
+
+template <is_BigInt_like TLHS, one_of<uint64_t, int64_t> TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator/(const TLHS &a, TRHS b) -> BigInt {
+	return divmod<TLHS, BigIntAdapter<TRHS>, false, true>(a, BigIntAdapter(b)).d;
+}
+
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator/(const TLHS &a, const TRHS &b) -> BigInt {
+	return divmod<TLHS, TRHS, false, true>(a, b).d;
+}
+
+
+template <one_of<uint32_t, int32_t> TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO_DISCARD
+operator/=(BigInt &a, TRHS b) -> BigInt& {
+	div(a, a, b);
+	a.cleanup();
+	return a;
+}
+
+template <one_of<uint64_t, int64_t> TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO_DISCARD
+operator/=(BigInt &a, TRHS b) -> BigInt& {
+	const auto result = divmod<BigInt, BigIntAdapter<TRHS>, false, true>(a, BigIntAdapter(b)).d;
+	a = std::move(result);
+	return a;
+}
+
+template <is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO_DISCARD
+operator/=(BigInt &a, const TRHS &b) -> BigInt& {
+	const auto result = divmod<BigInt, TRHS, false, true>(a, b).d;
+	a = std::move(result);
+	return a;
+}
+
+/**
+ * @brief floor(2^(64 k) / d), the reciprocal of d scaled by k digits, by Newton's iteration in a small multiple of the time of a multiplication.
+ *        Multiplying by it and shifting right by 64 k bits divides by d up to a small error, which pays off when many values are divided by the same d.
+ *
+ * @param d the divisor, may be negative
+ * @param k the scale in digits of base 2^64
+ * @return the rounded down reciprocal
+ */
+template <is_BigInt_like T>
+BIGINT_TRACY_CONSTEXPR_AUTO
+reciprocal(const T &d, std::size_t k) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	if (is_zero(d)) {
+		throw std::domain_error{utils::error_msg("division by zero")};
+	}
+	const auto tuning = _private::current_tuning();
+	auto [x, r] = _private::_reciprocal(_private::sliced(d, 0, d.size()), k, tuning.burnikel_ziegler_threshold);
+	if (is_neg(d)) {
+		if (!is_zero(r)) {
+			x += 1;
+		}
+		x.sign() = Sign::NEG;
+	}
+	return x;
+}
+
+}
+
+
+// Modulo:
+namespace bigint {
+
+template <is_BigInt_like TLHS, one_of<uint32_t, int32_t> TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator%(const TLHS &a, TRHS b) -> TRHS {
+	return divmod1<TLHS, true>(a, b).r; // we can trunccate safely because the divisor only also is uint32_t.
+}
+
+template <is_BigInt_like TLHS, one_of<uint64_t, int64_t> TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator%(const TLHS &a, TRHS b) -> TRHS {
+	return divmod<TLHS, true>(a, b).r;
+}
+
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator%(const TLHS &a, const TRHS &b) -> BigInt {
+	return divmod<TLHS, TRHS, true>(a, b).r;
+}
+
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator%=(TLHS &a, const TRHS &b) -> BigInt& {
+	const auto result = divmod<TLHS, TRHS, true>(a, b).r;
+	a = std::move(result);
+	return a;
+}
+
+}
+
+
+// fused multiply-add:
+namespace bigint::_private {
+
+/**
+ * @brief acc += a * b, or -= if negative, with the schoolbook rows of the product added straight into the digits of acc,
+ *        which hold acc in two's complement meanwhile. Requires that neither a nor b refers to acc.
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_VOID
+addmul_rows(BigInt &acc, const TLHS &a, const TRHS &b, bool negative) {
+	BIGINT_TRACY_ZONE_SCOPED;
+	const bool acc_negative = is_neg(acc);
+	acc.resize(std::max(acc.size(), a.size() + b.size()) + 1);
+	const auto digits = acc.digits();
+	if (acc_negative) {
+		negate_twos_complement(digits);
+	}
+	const auto [rows, row] = (a.size() < b.size()) ? std::pair{a.digits(), b.digits()} : std::pair{b.digits(), a.digits()};
+	for (std::size_t i = 0; i < rows.size(); ++i) {
+		accumulate_scaled(digits, row, i, rows[i], negative);
+	}
+	from_twos_complement(acc);
+}
+
+/**
+ * @brief acc += a * b, or -= if negative.
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_VOID
+addmul(BigInt &acc, const TLHS &a, const TRHS &b, bool negative) {
+	if constexpr (has_contiguous_digits<TLHS> && has_contiguous_digits<TRHS>) {
+		// a view starting anywhere in the storage of acc would see acc change while its digits are read.
+		const bool aliased = std::is_constant_evaluated()
+			|| points_into(a.digits().data(), acc.digits().data(), acc.capacity())
+			|| points_into(b.digits().data(), acc.digits().data(), acc.capacity());
+		if (!aliased && std::min(a.size(), b.size()) < current_tuning().karatsuba_threshold) {
+			addmul_rows(acc, a, b, negative != (mult_sign(a.sign(), b.sign()) == Sign::NEG));
+			return;
+		}
+	}
+	const BigInt product = mult(a, b);
+	acc = negative ? lazy(acc) - product : lazy(acc) + product;
+}
+
+}
+
+
+// fused multiply-add:
+namespace bigint {
+
+/**
+ * @brief acc += a * b. Small products are added to acc row by row as they are computed, without a temporary product.
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_VOID
+addmul(BigInt &acc, const TLHS &a, const TRHS &b) {
+	_private::addmul(acc, a, b, false);
+}
+
+/**
+ * @brief acc -= a * b. Small products are subtracted from acc row by row as they are computed, without a temporary product.
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_VOID
+submul(BigInt &acc, const TLHS &a, const TRHS &b) {
+	_private::addmul(acc, a, b, true);
+}
+
+/**
+ * @brief acc += a * b in a single pass over the digits of a.
+ */
+template <is_BigInt_like TLHS, std::integral TRHS>
+BIGINT_TRACY_CONSTEXPR_VOID
+addmul(BigInt &acc, const TLHS &a, TRHS b) {
+	if constexpr (_private::has_contiguous_digits<TLHS>) {
+		acc = lazy(acc) + lazy(a) * b;
+	} else {
+		acc += a * b;
+	}
+}
+
+/**
+ * @brief acc -= a * b in a single pass over the digits of a.
+ */
+template <is_BigInt_like TLHS, std::integral TRHS>
+BIGINT_TRACY_CONSTEXPR_VOID
+submul(BigInt &acc, const TLHS &a, TRHS b) {
+	if constexpr (_private::has_contiguous_digits<TLHS>) {
+		acc = lazy(acc) - lazy(a) * b;
+	} else {
+		acc -= a * b;
+	}
+}
+
+/**
+ * @brief (a * b) % m, with the sign of the remainder following operator%. Squares instead of multiplying if a and b are the same.
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS, is_BigInt_like TMOD>
+BIGINT_TRACY_CONSTEXPR_AUTO
+mulmod(const TLHS &a, const TRHS &b, const TMOD &m) -> BigInt {
+	BigInt product;
+	if constexpr (std::is_same_v<TLHS, TRHS>) {
+		product = (&a == &b) ? square(a) : mult(a, b);
+	} else {
+		product = mult(a, b);
+	}
+	return divmod<BigInt, TMOD, true>(product, m).r;
+}
+
+}
+
+
+// class BarrettReducer:
+namespace bigint {
+
+/**
+ * @brief division by a modulus m that stays the same for many divisions, like `x % m` in a loop or `pow_mod` with a fixed modulus.
+ *        What only depends on m is done once: a short m is normalized for Knuth's Algorithm D, one of n digits in the range
+ *        of Karatsuba and Toom-Cook multiplication gets its reciprocal floor(2^(128 n) / |m|) for Barrett reduction, which costs
+ *        two multiplications and at most two subtractions per n digits of the dividend. A single digit and a huge m are left to divmod(),
+ *        whose recursive algorithms beat two multiplications of transform size.
+ *        Quotients and remainders are those of operator/ and operator%, so the remainder has the sign of m.
+ */
+class BarrettReducer {
+public:
+	/**
+	 * @throws std::domain_error if modulus == 0
+	 */
+	template <is_BigInt_like T>
+	explicit constexpr
+	BarrettReducer(const T &modulus) : _modulus(modulus) {
+		BIGINT_TRACY_ZONE_SCOPED;
+		if (is_zero(_modulus)) {
+			throw std::domain_error{utils::error_msg("division by zero")};
+		}
+		const std::size_t n = _modulus.size();
+		const auto tuning = _private::current_tuning();
+		if (n >= tuning.karatsuba_threshold && n < tuning.ntt_threshold) {
+			_inverse = reciprocal(abs(_modulus), 2 * n);
+		} else if (n >= 2 && n < tuning.karatsuba_threshold) {
+			_shift = unsigned(std::countl_zero(_modulus[n - 1]));
+			_normalized.resize(n);
+			static_cast<void>(_private::_shifted_copy(_normalized, _modulus, _shift));
+		}
+	}
+
+	CONSTEXPR_AUTO
+	modulus() const noexcept -> const BigInt& {
+		return _modulus;
+	}
+
+	/**
+	 * @return x % modulus()
+	 */
+	template <is_BigInt_like T>
+	BIGINT_TRACY_CONSTEXPR_AUTO
+	reduce(const T &x) const -> BigInt {
+		return _divmod<true>(x).r;
+	}
+
+	/**
+	 * @brief replaces every value by value % modulus().
+	 */
+	BIGINT_TRACY_CONSTEXPR_VOID
+	reduce(std::span<BigInt> values) const {
+		for (auto &value : values) {
+			value = reduce(value);
+		}
+	}
+
+	/**
+	 * @return the same as bigint::divmod(x, modulus())
+	 */
+	template <is_BigInt_like T>
+	BIGINT_TRACY_CONSTEXPR_AUTO
+	divmod(const T &x) const -> DivModResult<BigInt> {
+		return _divmod<false>(x);
+	}
+
+private:
+	template <bool ignore_quotient, is_BigInt_like T>
+	BIGINT_TRACY_CONSTEXPR_AUTO
+	_divmod(const T &x) const -> DivModResult<BigInt> {
+		BIGINT_TRACY_ZONE_SCOPED;
+		auto [q, r] = _divmod_ignore_sign<ignore_quotient>(_private::sliced(x, 0, x.size()));
+
+		// the signs, as in bigint::divmod()
+		if (!is_zero(r)) {
+			if (is_neg(x)) {
+				r.sign() = Sign::NEG;
+			}
+			if (x.sign() != _modulus.sign()) {
+				r += _modulus;
+			}
+		}
+		if constexpr (!ignore_quotient) {
+			q.sign() = _private::mult_sign(x.sign(), _modulus.sign());
+			if (!is_zero(r) and q.sign() == Sign::NEG) {
+				q -= 1;
+			}
+			q.cleanup();
+		}
+		return {std::move(q), std::move(r)};
+	}
+
+	/**
+	 * @brief a / |m| and a % |m| for a >= 0 without leading zero digits.
+	 */
+	template <bool ignore_quotient, is_BigInt_like T>
+	BIGINT_TRACY_CONSTEXPR_AUTO
+	_divmod_ignore_sign(const T &a) const -> DivModResult<BigInt> {
+		const std::size_t n = _modulus.size();
+		if (a.size() < n) {
+			return {BigInt{0}, BigInt{a}};
+		}
+		if (!is_zero(_normalized)) {
+			return _private::_divmod_knuth_normalized<T, ignore_quotient, false>(a, _normalized, _shift);
+		}
+		if (is_zero(_inverse)) {
+			return _private::divmod_ignore_sign<T, BigInt, ignore_quotient, false>(a, _modulus);
+		}
+
+		// Barrett reduction of the top 2 n digits takes n digits off, until at most 2 n are left.
+		BigInt q;
+		BigInt r{a};
+		while (r.size() > 2 * n) {
+			const std::size_t start = r.size() - 2 * n;
+			auto [qi, ri] = _barrett(_private::sliced(r, start, 2 * n));
+			BigInt next = BigInt{_private::lshifted(std::move(ri), start)} + _private::sliced(r, 0, start);
+			r = std::move(next);
+			if constexpr (!ignore_quotient) {
+				q += _private::lshifted(std::move(qi), start);
+			}
+		}
+		if (r.size() >= n) {
+			auto [qi, ri] = _barrett(r);
+			r = std::move(ri);
+			if constexpr (!ignore_quotient) {
+				q += qi;
+			}
+		}
+		return {std::move(q), std::move(r)};
+	}
+
+	/**
+	 * @brief a / |m| and a % |m| for |m| <= a < 2^(128 n). The estimate of the quotient from the top n + 1 digits of a and the reciprocal
+	 *        is at most two too small.
+	 */
+	template <is_BigInt_like T>
+	BIGINT_TRACY_CONSTEXPR_AUTO
+	_barrett(const T &a) const -> DivModResult<BigInt> {
+		const std::size_t n = _modulus.size();
+		const auto m = _private::sliced(_modulus, 0, n);
+		const BigInt estimate = _private::_mult_reciprocal(_private::sliced(a, n - 1, n + 1), _inverse, n);
+		BigInt q{_private::sliced(estimate, n + 1, estimate.size())};
+		BigInt r = a - mult(q, m);
+		while (r >= m) {
+			r -= m;
+			q += 1;
+		}
+		return {std::move(q), std::move(r)};
+	}
+
+	BigInt _modulus;
+	BigInt _normalized{}; // |m| shifted left by _shift bits for Algorithm D if 2 <= n < karatsuba_threshold, else 0
+	unsigned _shift = 0;
+	BigInt _inverse{};    // floor(2^(128 n) / |m|) for Barrett reduction if karatsuba_threshold <= n < ntt_threshold, else 0
+};
+
+template <is_BigInt_like TLHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+operator%(const TLHS &a, const BarrettReducer &m) -> BigInt {
+	return m.reduce(a);
+}
+
+BIGINT_TRACY_CONSTEXPR_AUTO_DISCARD
+operator%=(BigInt &a, const BarrettReducer &m) -> BigInt& {
+	a = m.reduce(a);
+	return a;
+}
+
+/**
+ * @brief (a * b) % m, with the sign of the remainder following operator%. Squares instead of multiplying if a and b are the same.
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+mulmod(const TLHS &a, const TRHS &b, const BarrettReducer &m) -> BigInt {
+	if constexpr (std::is_same_v<TLHS, TRHS>) {
+		if (&a == &b) {
+			return m.reduce(square(a));
+		}
+	}
+	return m.reduce(mult(a, b));
+}
+
+}
+
+
+// class MontgomeryContext:
+namespace bigint {
+
+/**
+ * @brief multiplication modulo an odd m of n digits without any division, on values in Montgomery form x R mod |m| for R = 2^(64 n).
+ *        mult() calculates a b R^-1 mod |m| by Coarsely Integrated Operand Scanning (CIOS): for every digit b[i], one pass adds a b[i]
+ *        and a second one adds the multiple of |m| that clears the lowest digit, which is then dropped. The sum stays below 2 |m|,
+ *        so a single subtraction at the end is enough. The context precomputes -m^-1 mod 2^64 and R^2 mod |m|,
+ *        so converting into Montgomery form is one more mult().
+ */
+class MontgomeryContext {
+public:
+	/**
+	 * @throws std::domain_error if modulus is even or zero
+	 */
+	template <is_BigInt_like T>
+	explicit constexpr
+	MontgomeryContext(const T &modulus) : _modulus(modulus), _magnitude(abs(modulus)) {
+		BIGINT_TRACY_ZONE_SCOPED;
+		if (_modulus[0] % 2 == 0) {
+			throw std::domain_error{utils::error_msg("Montgomery multiplication needs an odd modulus.")};
+		}
+		const std::size_t n = _magnitude.size();
+		_m_inv_neg = 0 - utils::inverse_mod_2_64(_magnitude[0]);
+		_r2 = (BigInt{1} << 128 * n) % _magnitude;
+		_r2.resize(n);
+	}
+
+	CONSTEXPR_AUTO
+	modulus() const noexcept -> const BigInt& {
+		return _modulus;
+	}
+
+	/**
+	 * @return x R mod |m|
+	 */
+	template <is_BigInt_like T>
+	BIGINT_TRACY_CONSTEXPR_AUTO
+	to_montgomery(const T &x) const -> BigInt {
+		BigInt result = x % _magnitude;
+		result.resize(_magnitude.size());
+		_mult_in_place(result, _r2);
+		result.cleanup();
+		return result;
+	}
+
+	/**
+	 * @return x R^-1 mod |m| for 0 <= x < |m|
+	 */
+	template <is_BigInt_like T>
+	BIGINT_TRACY_CONSTEXPR_AUTO
+	from_montgomery(const T &x) const -> BigInt {
+		BigInt one;
+		one.resize(_magnitude.size());
+		one.digits()[0] = 1;
+		_mult_in_place(one, _padded(x));
+		one.cleanup();
+		return one;
+	}
+
+	/**
+	 * @return a b R^-1 mod |m| for 0 <= a, b < |m|, which is the Montgomery form of the product if a and b are in Montgomery form.
+	 */
+	template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+	BIGINT_TRACY_CONSTEXPR_AUTO
+	mult(const TLHS &a, const TRHS &b) const -> BigInt {
+		BigInt result = _padded(a);
+		_mult_in_place(result, _padded(b));
+		result.cleanup();
+		return result;
+	}
+
+	/**
+	 * @return base^exp % modulus() for exp >= 0, by left-to-right binary exponentiation in Montgomery form.
+	 * @throws std::domain_error if exp < 0 or base == exp == 0
+	 */
+	template <is_BigInt_like BASE, is_BigInt_like EXP>
+	BIGINT_TRACY_CONSTEXPR_AUTO
+	pow(const BASE &base, const EXP &exp) const -> BigInt {
+		BIGINT_TRACY_ZONE_SCOPED;
+		if (is_neg(exp)) {
+			throw std::domain_error{utils::error_msg("the exponent must not be negative.")};
+		} else if (is_zero(exp)) {
+			if (is_zero(base)) {
+				throw std::domain_error{utils::error_msg("zero to the power of zero is undefined.")};
+			}
+			return BigInt{1} % _modulus;
+		}
+		const std::size_t n = _magnitude.size();
+		BigInt x = to_montgomery(base);
+		x.resize(n);
+		BigInt result = x;
+		BigInt scratch;
+		scratch.resize(2 * n + 1);
+		const uint64_t *const x_digits = x.digits().data();
+		uint64_t *const r = result.digits().data();
+		uint64_t *const t = scratch.digits().data();
+
+		const std::size_t exp_bits = 64 * exp.size() - std::countl_zero(exp[exp.size() - 1]);
+		for (std::size_t i = exp_bits - 1; i-- > 0;) {
+			_mult(r, r, r, t);
+			if ((exp[i / 64] >> (i % 64)) & 1) {
+				_mult(r, r, x_digits, t);
+			}
+		}
+		result = from_montgomery(result);
+		if (!is_zero(result) && is_neg(_modulus)) {
+			result += _modulus;
+		}
+		return result;
+	}
+
+private:
+	/// x as exactly n digits, for 0 <= x < |m|.
+	template <is_BigInt_like T>
+	BIGINT_TRACY_CONSTEXPR_AUTO
+	_padded(const T &x) const -> BigInt {
+		BigInt result{_private::sliced(x, 0, x.size())};
+		result.resize(_magnitude.size());
+		return result;
+	}
+
+	/// a = a b R^-1 mod |m|, both of n digits.
+	BIGINT_TRACY_CONSTEXPR_VOID
+	_mult_in_place(BigInt &a, const BigInt &b) const {
+		BigInt scratch;
+		scratch.resize(2 * _magnitude.size() + 1);
+		_mult(a.digits().data(), a.digits().data(), b.digits().data(), scratch.digits().data());
+	}
+
+	/**
+	 * @brief r = a b R^-1 mod |m| for a, b < |m| of n digits. r may be a or b, t is scratch memory of 2 n + 1 digits.
+	 *        Instead of dropping the cleared lowest digit, step i works on t + i.
+	 */
+	CONSTEXPR_VOID
+	_mult(uint64_t *r, const uint64_t *a, const uint64_t *b, uint64_t *t) const noexcept {
+		const std::size_t n = _magnitude.size();
+		const uint64_t *const m = _magnitude.digits().data();
+		std::fill_n(t, 2 * n + 1, 0);
+		for (std::size_t i = 0; i < n; ++i) {
+			uint64_t *const ti = t + i;
+			uint8_t c = 0;
+			ti[n] = utils::add_carry(ti[n], kernels::addmul_1(ti, a, n, b[i]), c);
+			ti[n + 1] = c;
+			const uint64_t q = ti[0] * _m_inv_neg; // ti[0] + q m[0] == 0 mod 2^64
+			c = 0;
+			ti[n] = utils::add_carry(ti[n], kernels::addmul_1(ti, m, n, q), c);
+			ti[n + 1] += c;
+		}
+
+		// t[n, 2 n] < 2 |m|
+		const uint64_t *const u = t + n;
+		bool subtract = u[n] != 0;
+		if (!subtract) {
+			std::size_t i = n;
+			while (i > 0 && u[i - 1] == m[i - 1]) {
+				--i;
+			}
+			subtract = (i == 0) || u[i - 1] > m[i - 1];
+		}
+		if (subtract) {
+			static_cast<void>(kernels::sub_n(r, u, m, n));
+		} else {
+			std::copy_n(u, n, r);
+		}
+	}
+
+	BigInt _modulus;
+	BigInt _magnitude;      // |m|
+	uint64_t _m_inv_neg = 0; // -m^-1 mod 2^64
+	BigInt _r2;             // R^2 mod |m|, to convert into Montgomery form
+};
+
+}
+
+
+// class FixedBigInt:
+namespace bigint {
+
+/**
+ * @brief what FixedBigInt does with results whose magnitude does not fit.
+ */
+enum class Overflow {
+	WRAP,     ///< keep the magnitude modulo 2^(64 N), like unsigned integers do. The sign is kept.
+	SATURATE, ///< clamp the magnitude to 2^(64 N) - 1. The sign is kept.
+};
+
+}
+
+namespace bigint::_private {
+
+/**
+ * @brief calls f(std::integral_constant<std::size_t, I>{}) for I = 0 ... N-1, unrolled.
+ */
+template <std::size_t N, typename F>
+CONSTEXPR_VOID
+unrolled(F &&f) {
+	[&]<std::size_t... I>(std::index_sequence<I...>) {
+		(f(std::integral_constant<std::size_t, I>{}), ...);
+	}(std::make_index_sequence<N>{});
+}
+
+/**
+ * @brief r = a + b on N digits, unrolled for small N.
+ * @return the carry
+ */
+template <std::size_t N>
+CONSTEXPR_AUTO
+fixed_add_n(uint64_t *r, const uint64_t *a, const uint64_t *b) noexcept -> uint64_t {
+	if constexpr (N <= BIGINT_FIXED_UNROLL_LIMIT) {
+		uint8_t c = 0;
+		unrolled<N>([&](auto i) { r[i] = utils::add_carry(a[i], b[i], c); });
+		return c;
+	} else {
+		return kernels::add_n(r, a, b, N);
+	}
+}
+
+/**
+ * @brief r = a - b on N digits, unrolled for small N.
+ * @return the borrow
+ */
+template <std::size_t N>
+CONSTEXPR_AUTO
+fixed_sub_n(uint64_t *r, const uint64_t *a, const uint64_t *b) noexcept -> uint64_t {
+	if constexpr (N <= BIGINT_FIXED_UNROLL_LIMIT) {
+		uint8_t c = 0;
+		unrolled<N>([&](auto i) { r[i] = utils::sub_borrow(a[i], b[i], c); });
+		return c;
+	} else {
+		return kernels::sub_n(r, a, b, N);
+	}
+}
+
+/**
+ * @brief the schoolbook product of two N digit numbers, unrolled for small N.
+ *        If low_only, only the N low digits of r are calculated, the others are left zero.
+ */
+template <std::size_t N, bool low_only>
+CONSTEXPR_AUTO
+fixed_mul(const uint64_t *a, const uint64_t *b) noexcept -> std::array<uint64_t, 2 * N> {
+	std::array<uint64_t, 2 * N> r{};
+	if constexpr (N <= BIGINT_FIXED_UNROLL_LIMIT) {
+		unrolled<N>([&](auto i) {
+			uint64_t carry = 0;
+			unrolled<low_only ? N - i : N>([&](auto j) {
+				uint64_t high = 0;
+				uint8_t c = 0;
+				uint64_t low = utils::mult_u128(a[j], b[i], high);
+				low = utils::add_carry(low, carry, c);
+				high += c;
+				c = 0;
+				r[i + j] = utils::add_carry(r[i + j], low, c);
+				carry = high + c;
+			});
+			if constexpr (!low_only) {
+				r[i + N] = carry;
+			}
+		});
+	} else {
+		for (std::size_t i = 0; i < N; ++i) {
+			const uint64_t carry = kernels::addmul_1(r.data() + i, a, low_only ? N - i : N, b[i]);
+			if constexpr (!low_only) {
+				r[i + N] = carry;
+			}
+		}
+	}
+	return r;
+}
+
+}
+
+namespace bigint {
+
+/**
+ * @brief an integer of at most N digits (64 N bits) plus a sign, stored inline without any allocation.
+ *        +, -, *, / and % of two FixedBigInt<N, overflow> give a FixedBigInt again, with the overflow policy applied to the result,
+ *        and so do the compound assignments, which also accept integers and other BigInt-like values.
+ *        Addition, subtraction and multiplication use unrolled loops for up to BIGINT_FIXED_UNROLL_LIMIT digits and the limb kernels beyond.
+ *        Mixed with integers or other BigInt-like values, FixedBigInt takes part in all the usual operators, which then return a BigInt.
+ */
+template <std::size_t N, Overflow overflow = Overflow::WRAP>
+class FixedBigInt : public IBigIntLike {
+	static_assert(N >= 1, "FixedBigInt needs at least one digit.");
+	static_assert(N <= std::numeric_limits<uint32_t>::max());
+public:
+	constexpr
+	FixedBigInt() noexcept {}
+
+	explicit constexpr
+	FixedBigInt(std::integral auto v) noexcept {
+		_digits[0] = utils::constexpr_abs(v);
+		_sign = (v < 0) ? Sign::NEG : Sign::POS;
+		normalize();
+	}
+
+	/**
+	 * @brief converts any BigInt-like value, applying the overflow policy if it has more than N digits.
+	 */
+	template <is_BigInt_like T>
+	explicit constexpr
+	FixedBigInt(const T &v) {
+		bool overflowed = false;
+		for (std::size_t i = 0; i < v.size(); ++i) {
+			if (i < N) {
+				_digits[i] = v[i];
+			} else if (v[i] != 0) {
+				overflowed = true;
+			}
+		}
+		_sign = v.sign();
+		if (overflowed) {
+			handle_overflow();
+		}
+		normalize();
+	}
+
+	constexpr
+	~FixedBigInt() noexcept {}
+
+	constexpr
+	FixedBigInt(const FixedBigInt &other) noexcept // copy constructor
+		: _digits(other._digits), _size(other._size), _sign(other._sign)
+	{ }
+
+	constexpr
+	FixedBigInt(FixedBigInt &&other) noexcept // move constructor
+		: _digits(other._digits), _size(other._size), _sign(other._sign)
+	{ }
+
+	CONSTEXPR_AUTO_DISCARD
+	operator=(const FixedBigInt &other) noexcept -> FixedBigInt& { // copy assignment
+		_digits = other._digits;
+		_size = other._size;
+		_sign = other._sign;
+		return *this;
+	}
+
+	CONSTEXPR_AUTO_DISCARD
+	operator=(FixedBigInt &&other) noexcept -> FixedBigInt& { // move assignment
+		return *this = other;
+	}
+
+	/**
+	 * @brief the largest representable value, 2^(64 N) - 1.
+	 */
+	[[nodiscard]] static constexpr auto
+	max() noexcept -> FixedBigInt {
+		FixedBigInt result;
+		result._digits.fill(~uint64_t{0});
+		result._size = N;
+		return result;
+	}
+
+	CONSTEXPR_AUTO
+	sign() const noexcept -> Sign {
+		return _sign;
+	}
+
+	CONSTEXPR_AUTO
+	size() const noexcept -> std::size_t {
+		return _size;
+	}
+
+	CONSTEXPR_AUTO
+	operator[](std::size_t index) const noexcept -> uint64_t {
+		return (index >= N) ? 0 : _digits[index];
+	}
+
+	CONSTEXPR_AUTO
+	digits() const noexcept -> std::span<const uint64_t> {
+		return {_digits.data(), _size};
+	}
+
+	friend constexpr auto
+	operator-(FixedBigInt a) noexcept -> FixedBigInt {
+		if (!is_zero(a)) {
+			a._sign = _private::neg(a._sign);
+		}
+		return a;
+	}
+
+	friend constexpr auto
+	operator+(const FixedBigInt &a, const FixedBigInt &b) noexcept -> FixedBigInt {
+		return add(a, b, b._sign);
+	}
+
+	friend constexpr auto
+	operator-(const FixedBigInt &a, const FixedBigInt &b) noexcept -> FixedBigInt {
+		return add(a, b, _private::neg(b._sign));
+	}
+
+	friend constexpr auto
+	operator*(const FixedBigInt &a, const FixedBigInt &b) noexcept -> FixedBigInt {
+		FixedBigInt result;
+		if constexpr (overflow == Overflow::WRAP) {
+			const auto product = _private::fixed_mul<N, true>(a._digits.data(), b._digits.data());
+			std::copy_n(product.begin(), N, result._digits.begin());
+		} else {
+			const auto product = _private::fixed_mul<N, false>(a._digits.data(), b._digits.data());
+			std::copy_n(product.begin(), N, result._digits.begin());
+			if (std::any_of(product.begin() + N, product.end(), [](uint64_t digit) { return digit != 0; })) {
+				result.handle_overflow();
+			}
+		}
+		result._sign = _private::mult_sign(a._sign, b._sign);
+		result.normalize();
+		return result;
+	}
+
+	/**
+	 * @brief rounds towards negative infinity like BigInt does. Throws std::domain_error if b is zero.
+	 */
+	friend constexpr auto
+	operator/(const FixedBigInt &a, const FixedBigInt &b) -> FixedBigInt {
+		return FixedBigInt{divmod<FixedBigInt, FixedBigInt, false, true>(a, b).d};
+	}
+
+	/**
+	 * @brief the remainder has the sign of b like for BigInt. Throws std::domain_error if b is zero.
+	 */
+	friend constexpr auto
+	operator%(const FixedBigInt &a, const FixedBigInt &b) -> FixedBigInt {
+		return FixedBigInt{divmod<FixedBigInt, FixedBigInt, true, false>(a, b).r};
+	}
+
+	/**
+	 * @brief the compound assignments also accept any BigInt-like value or integer, and convert the result back.
+	 */
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend constexpr auto
+	operator+=(FixedBigInt &a, const T &b) -> FixedBigInt& {
+		if constexpr (is_BigInt_like<T> && !std::is_same_v<T, FixedBigInt>) {
+			if (b.size() > N) {
+				return a = FixedBigInt{a + b}; // b does not fit, while the sum may
+			}
+		}
+		return a = a + fixed(b);
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend constexpr auto
+	operator-=(FixedBigInt &a, const T &b) -> FixedBigInt& {
+		if constexpr (is_BigInt_like<T> && !std::is_same_v<T, FixedBigInt>) {
+			if (b.size() > N) {
+				return a = FixedBigInt{a - b}; // b does not fit, while the difference may
+			}
+		}
+		return a = a - fixed(b);
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend constexpr auto
+	operator*=(FixedBigInt &a, const T &b) -> FixedBigInt& {
+		if constexpr (is_BigInt_like<T> && !std::is_same_v<T, FixedBigInt>) {
+			return a = FixedBigInt{mult(a, b)}; // b may not fit, while the product does
+		} else {
+			return a = a * fixed(b);
+		}
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend constexpr auto
+	operator/=(FixedBigInt &a, const T &b) -> FixedBigInt& {
+		if constexpr (is_BigInt_like<T> && !std::is_same_v<T, FixedBigInt>) {
+			return a = FixedBigInt{divmod<FixedBigInt, T, false, true>(a, b).d};
+		} else {
+			return a = a / fixed(b);
+		}
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend constexpr auto
+	operator%=(FixedBigInt &a, const T &b) -> FixedBigInt& {
+		if constexpr (is_BigInt_like<T> && !std::is_same_v<T, FixedBigInt>) {
+			return a = FixedBigInt{divmod<FixedBigInt, T, true, false>(a, b).r};
+		} else {
+			return a = a % fixed(b);
+		}
+	}
+
+private:
+	std::array<uint64_t, N> _digits{};
+	uint32_t _size = 1; // without leading zeros, at least 1
+	Sign _sign = Sign::POS;
+
+	template <typename T>
+	static constexpr auto
+	fixed(const T &v) -> FixedBigInt {
+		if constexpr (std::is_same_v<T, FixedBigInt>) {
+			return v;
+		} else if constexpr (is_BigInt_like<T>) {
+			return FixedBigInt{v};
+		} else {
+			return FixedBigInt{v};
+		}
+	}
+
+	/**
+	 * @brief a + b with b's sign replaced by b_sign.
+	 */
+	static constexpr auto
+	add(const FixedBigInt &a, const FixedBigInt &b, Sign b_sign) noexcept -> FixedBigInt {
+		FixedBigInt result;
+		if (a._sign == b_sign || is_zero(b)) {
+			result._sign = a._sign;
+			if (_private::fixed_add_n<N>(result._digits.data(), a._digits.data(), b._digits.data()) != 0) {
+				result.handle_overflow();
+			}
+		} else if (compare_magnitudes(a, b) >= 0) {
+			result._sign = a._sign;
+			static_cast<void>(_private::fixed_sub_n<N>(result._digits.data(), a._digits.data(), b._digits.data()));
+		} else {
+			result._sign = b_sign;
+			static_cast<void>(_private::fixed_sub_n<N>(result._digits.data(), b._digits.data(), a._digits.data()));
+		}
+		result.normalize();
+		return result;
+	}
+
+	static constexpr auto
+	compare_magnitudes(const FixedBigInt &a, const FixedBigInt &b) noexcept -> int {
+		if (a._size != b._size) {
+			return (a._size < b._size) ? -1 : 1;
+		}
+		for (std::size_t i = a._size; i-- > 0;) {
+			if (a._digits[i] != b._digits[i]) {
+				return (a._digits[i] < b._digits[i]) ? -1 : 1;
+			}
+		}
+		return 0;
+	}
+
+	/**
+	 * @brief called when the magnitude of the result did not fit. With wrapping the low digits are already correct.
+	 */
+	CONSTEXPR_VOID
+	handle_overflow() noexcept {
+		if constexpr (overflow == Overflow::SATURATE) {
+			_digits.fill(~uint64_t{0});
+		}
+	}
+
+	CONSTEXPR_VOID
+	normalize() noexcept {
+		_size = N;
+		while (_size > 1 && _digits[_size - 1] == 0) {
+			--_size;
+		}
+		if (_size == 1 && _digits[0] == 0) {
+			_sign = Sign::POS;
+		}
+	}
+};
+
+}
+
+
+// class SmallBigInt:
+namespace bigint {
+
+/**
+ * @brief a pointer sized handle for values that mostly fit into a machine word. Values in [-2^62, 2^62) are stored inline,
+ *        tagged by the lowest bit; only larger ones own a heap allocated BigInt.
+ *        +, -, *, /, % and the comparisons of two inline values are machine operations with an overflow check,
+ *        only on overflow (or if an operand is on the heap) the BigInt path is taken. Results that fit are always stored inline again.
+ *        The compound assignments also accept integers and other BigInt-like values.
+ *        Mixed with integers or other BigInt-like values, SmallBigInt takes part in all the usual operators, which then return a BigInt.
+ *        Unlike the other BigInt-like types it is not constexpr, since it stores a pointer and a small value in the same bits.
+ */
+class SmallBigInt : public IBigIntLike {
+public:
+	static constexpr int64_t inline_min = -(int64_t{1} << 62);
+	static constexpr int64_t inline_max = (int64_t{1} << 62) - 1;
+
+	SmallBigInt() noexcept {}
+
+	explicit
+	SmallBigInt(std::integral auto v) {
+		if (std::cmp_greater_equal(v, inline_min) && std::cmp_less_equal(v, inline_max)) {
+			_bits = tagged(static_cast<int64_t>(v));
+		} else {
+			_bits = boxed(BigInt{v});
+		}
+	}
+
+	template <is_BigInt_like T>
+	explicit
+	SmallBigInt(const T &v) {
+		store(BigInt{v});
+	}
+
+	explicit
+	SmallBigInt(BigInt &&v) {
+		store(std::move(v));
+	}
+
+	~SmallBigInt() noexcept {
+		release();
+	}
+
+	SmallBigInt(const SmallBigInt &other) // copy constructor
+		: _bits(other.is_inline() ? other._bits : boxed(BigInt{other.big()}))
+	{ }
+
+	SmallBigInt(SmallBigInt &&other) noexcept // move constructor
+		: _bits(std::exchange(other._bits, tagged(0)))
+	{ }
+
+	auto
+	operator=(const SmallBigInt &other) -> SmallBigInt& { // copy assignment, reuses the heap value if both have one
+		if (other.is_inline()) {
+			release();
+			_bits = other._bits;
+		} else if (!is_inline()) {
+			big() = other.big();
+		} else {
+			_bits = boxed(BigInt{other.big()});
+		}
+		return *this;
+	}
+
+	auto
+	operator=(SmallBigInt &&other) noexcept -> SmallBigInt& { // move assignment
+		std::swap(_bits, other._bits);
+		return *this;
+	}
+
+	/**
+	 * @brief whether the value is stored inline, i.e. lies in [inline_min, inline_max].
+	 */
+	NODISCARD_AUTO
+	is_inline() const noexcept -> bool {
+		return (_bits & 1) != 0;
+	}
+
+	NODISCARD_AUTO
+	sign() const noexcept -> Sign {
+		if (is_inline()) {
+			return small() < 0 ? Sign::NEG : Sign::POS;
+		}
+		return big().sign();
+	}
 
-		uint64_t d = utils::div_u128_saturate(yz_hi, yz_lo, e); // yz/e;
+	NODISCARD_AUTO
+	size() const noexcept -> std::size_t {
+		return is_inline() ? 1 : big().size();
+	}
+
+	NODISCARD_AUTO
+	operator[](std::size_t index) const noexcept -> uint64_t {
+		if (is_inline()) {
+			return (index == 0) ? utils::constexpr_abs(small()) : 0;
+		}
+		return big()[index];
+	}
+
+	/**
+	 * @brief calls f with the value as a BigIntAdapter<int64_t> if it is inline, as a const BigInt& otherwise.
+	 */
+	template <typename F>
+	NODISCARD_AUTO
+	visit(F &&f) const -> decltype(auto) {
+		if (is_inline()) {
+			return f(BigIntAdapter<int64_t>{small()});
+		}
+		return f(big());
+	}
+
+	friend auto
+	operator-(const SmallBigInt &a) -> SmallBigInt {
+		if (a.is_inline() && a._bits != tagged(inline_min)) {
+			return from_bits(tagged(-a.small()));
+		}
+		return a.visit([](const auto &x) { return SmallBigInt{BigInt{-x}}; });
+	}
+
+	friend auto
+	operator+(const SmallBigInt &a, const SmallBigInt &b) -> SmallBigInt {
+		if (a.is_inline() && b.is_inline()) {
+			return SmallBigInt{a.small() + b.small()}; // 63 bit operands never overflow 64 bits
+		}
+		return combined(a, b, [](const auto &x, const auto &y) { return BigInt{x + y}; });
+	}
+
+	friend auto
+	operator-(const SmallBigInt &a, const SmallBigInt &b) -> SmallBigInt {
+		if (a.is_inline() && b.is_inline()) {
+			return SmallBigInt{a.small() - b.small()};
+		}
+		return combined(a, b, [](const auto &x, const auto &y) { return BigInt{x - y}; });
+	}
+
+	friend auto
+	operator*(const SmallBigInt &a, const SmallBigInt &b) -> SmallBigInt {
+		if (a.is_inline() && b.is_inline()) {
+			uint64_t high = 0;
+			const uint64_t low = utils::mult_u128(utils::constexpr_abs(a.small()), utils::constexpr_abs(b.small()), high);
+			const bool negative = (a.small() < 0) != (b.small() < 0);
+			if (high == 0 && low <= (negative ? uint64_t(-inline_min) : uint64_t(inline_max))) {
+				return from_bits(tagged(negative ? -int64_t(low) : int64_t(low)));
+			}
+		}
+		return combined(a, b, [](const auto &x, const auto &y) { return BigInt{x * y}; });
+	}
+
+	/**
+	 * @brief rounds towards negative infinity like BigInt does. Throws std::domain_error if b is zero.
+	 */
+	friend auto
+	operator/(const SmallBigInt &a, const SmallBigInt &b) -> SmallBigInt {
+		if (a.is_inline() && b.is_inline() && b.small() != 0) {
+			return SmallBigInt{floor_divmod(a.small(), b.small()).first};
+		}
+		return combined(a, b, [](const auto &x, const auto &y) { return BigInt{x / y}; });
+	}
+
+	/**
+	 * @brief the remainder has the sign of b like for BigInt. Throws std::domain_error if b is zero.
+	 */
+	friend auto
+	operator%(const SmallBigInt &a, const SmallBigInt &b) -> SmallBigInt {
+		if (a.is_inline() && b.is_inline() && b.small() != 0) {
+			return from_bits(tagged(floor_divmod(a.small(), b.small()).second));
+		}
+		return combined(a, b, [](const auto &x, const auto &y) { return BigInt{x % y}; });
+	}
+
+	friend auto
+	operator==(const SmallBigInt &a, const SmallBigInt &b) -> bool {
+		if (a.is_inline() || b.is_inline()) {
+			return a._bits == b._bits; // a value that fits is never on the heap
+		}
+		return a.big() == b.big();
+	}
+
+	friend auto
+	operator<=>(const SmallBigInt &a, const SmallBigInt &b) -> std::strong_ordering {
+		if (a.is_inline() && b.is_inline()) {
+			return a.small() <=> b.small();
+		}
+		return a.visit([&](const auto &x) { return b.visit([&](const auto &y) { return x <=> y; }); });
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend auto
+	operator+=(SmallBigInt &a, const T &b) -> SmallBigInt& {
+		return assign(a, b, [](const auto &x, const auto &y) { return x + y; });
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend auto
+	operator-=(SmallBigInt &a, const T &b) -> SmallBigInt& {
+		return assign(a, b, [](const auto &x, const auto &y) { return x - y; });
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend auto
+	operator*=(SmallBigInt &a, const T &b) -> SmallBigInt& {
+		return assign(a, b, [](const auto &x, const auto &y) { return x * y; });
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend auto
+	operator/=(SmallBigInt &a, const T &b) -> SmallBigInt& {
+		return assign(a, b, [](const auto &x, const auto &y) { return x / y; });
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend auto
+	operator%=(SmallBigInt &a, const T &b) -> SmallBigInt& {
+		return assign(a, b, [](const auto &x, const auto &y) { return x % y; });
+	}
+
+	friend void
+	swap(SmallBigInt &a, SmallBigInt &b) noexcept {
+		std::swap(a._bits, b._bits);
+	}
+
+private:
+	static_assert(alignof(BigInt) >= 2, "the lowest bit of a BigInt* is used as the tag.");
+	static_assert(sizeof(uintptr_t) == sizeof(int64_t), "the inline values need 64 bit pointers.");
+
+	uintptr_t _bits = tagged(0); // (value << 1) | 1 if inline, BigInt* otherwise
+
+	static constexpr auto
+	tagged(int64_t v) noexcept -> uintptr_t {
+		return (uintptr_t(v) << 1) | 1;
+	}
+
+	static auto
+	boxed(BigInt &&v) -> uintptr_t {
+		return reinterpret_cast<uintptr_t>(new BigInt(std::move(v)));
+	}
+
+	static auto
+	from_bits(uintptr_t bits) noexcept -> SmallBigInt {
+		SmallBigInt result;
+		result._bits = bits;
+		return result;
+	}
+
+	/**
+	 * @brief the quotient rounded towards negative infinity and the remainder with the sign of b.
+	 */
+	static auto
+	floor_divmod(int64_t a, int64_t b) noexcept -> std::pair<int64_t, int64_t> {
+		int64_t q = a / b;
+		int64_t r = a % b;
+		if (r != 0 && (r < 0) != (b < 0)) {
+			--q;
+			r += b;
+		}
+		return {q, r};
+	}
+
+	/**
+	 * @brief the BigInt path: op is called with each operand as a BigIntAdapter<int64_t> or a const BigInt& and returns a BigInt.
+	 */
+	template <typename Op>
+	static auto
+	combined(const SmallBigInt &a, const SmallBigInt &b, Op &&op) -> SmallBigInt {
+		return a.visit([&](const auto &x) {
+			return b.visit([&](const auto &y) { return SmallBigInt{op(x, y)}; });
+		});
+	}
+
+	template <typename T, typename Op>
+	static auto
+	assign(SmallBigInt &a, const T &b, Op &&op) -> SmallBigInt& {
+		if constexpr (std::is_same_v<T, SmallBigInt>) {
+			a = op(a, b);
+		} else if constexpr (std::integral<T>) {
+			a = op(a, SmallBigInt{b});
+		} else {
+			a = a.visit([&](const auto &x) { return SmallBigInt{BigInt{op(x, b)}}; });
+		}
+		return a;
+	}
+
+	NODISCARD_AUTO
+	small() const noexcept -> int64_t {
+		return static_cast<int64_t>(_bits) >> 1;
+	}
+
+	NODISCARD_AUTO
+	big() const noexcept -> const BigInt& {
+		return *reinterpret_cast<const BigInt*>(_bits);
+	}
+
+	NODISCARD_AUTO
+	big() noexcept -> BigInt& {
+		return *reinterpret_cast<BigInt*>(_bits);
+	}
+
+	/**
+	 * @brief stores v inline if it fits, keeps the heap value if there already is one.
+	 */
+	void
+	store(BigInt &&v) {
+		if (v.size() == 1 && v[0] <= (is_neg(v) ? uint64_t(-inline_min) : uint64_t(inline_max))) {
+			release();
+			_bits = tagged(is_neg(v) ? -int64_t(v[0]) : int64_t(v[0]));
+		} else if (!is_inline()) {
+			big() = std::move(v);
+		} else {
+			_bits = boxed(std::move(v));
+		}
+	}
+
+	void
+	release() noexcept {
+		if (!is_inline()) {
+			delete &big();
+			_bits = tagged(0);
+		}
+	}
+};
+
+static_assert(sizeof(SmallBigInt) == sizeof(void*));
+
+}
+
+
+// class SharedBigInt:
+namespace bigint {
+
+/**
+ * @brief an immutable BigInt shared by reference counting: copies take O(1) and may be passed to other threads.
+ *        Mutating a copy through set(), append() or a compound assignment first detaches it from the others (copy-on-write),
+ *        so a shared value is never modified. Reading from it is as fast as from a BigInt, it has contiguous digits.
+ *        The digits always come from the global heap, as shared values tend to outlive any ScopedMemoryResource.
+ *        Like the reference count of std::shared_ptr, only the value is shared safely: a single SharedBigInt object
+ *        must not be mutated while another thread copies or reads it.
+ */
+class SharedBigInt : public IBigIntLike {
+public:
+	SharedBigInt() : _value(zero()) {}
+
+	explicit
+	SharedBigInt(std::integral auto v) : _value(make(BigInt{v})) {}
+
+	template <is_BigInt_like T>
+	explicit
+	SharedBigInt(const T &v) : _value(make(v)) {}
+
+	/**
+	 * @brief takes v's storage, unless it came from a memory resource. Then the digits are copied to the global heap.
+	 */
+	explicit
+	SharedBigInt(BigInt &&v) : _value(make(std::move(v))) {}
+
+	NODISCARD_AUTO
+	sign() const noexcept -> Sign {
+		return _value->sign();
+	}
+
+	NODISCARD_AUTO
+	size() const noexcept -> std::size_t {
+		return _value->size();
+	}
+
+	NODISCARD_AUTO
+	operator[](std::size_t index) const noexcept -> uint64_t {
+		return (*_value)[index];
+	}
+
+	NODISCARD_AUTO
+	digits() const noexcept -> std::span<const uint64_t> {
+		return _value->digits();
+	}
+
+	/**
+	 * @brief the shared value. The reference is invalidated by mutating this SharedBigInt.
+	 */
+	NODISCARD_AUTO
+	value() const noexcept -> const BigInt& {
+		return *_value;
+	}
+
+	/**
+	 * @brief the number of SharedBigInts sharing the value, like std::shared_ptr::use_count() only approximate if other threads copy it.
+	 */
+	NODISCARD_AUTO
+	use_count() const noexcept -> long {
+		return _value.use_count();
+	}
+
+	void
+	set(std::size_t index, uint64_t digit) {
+		mutate([&](BigInt &v) { v.set(index, digit); });
+	}
+
+	void
+	append(uint64_t digit) {
+		mutate([&](BigInt &v) { v.append(digit); });
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend auto
+	operator+=(SharedBigInt &a, const T &b) -> SharedBigInt& {
+		return a.mutate([&](BigInt &v) { v += unwrap(b); });
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend auto
+	operator-=(SharedBigInt &a, const T &b) -> SharedBigInt& {
+		return a.mutate([&](BigInt &v) { v -= unwrap(b); });
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend auto
+	operator*=(SharedBigInt &a, const T &b) -> SharedBigInt& {
+		return a.mutate([&](BigInt &v) { v *= unwrap(b); });
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend auto
+	operator/=(SharedBigInt &a, const T &b) -> SharedBigInt& {
+		return a.mutate([&](BigInt &v) { v /= unwrap(b); });
+	}
+
+	template <typename T> requires is_BigInt_like<T> || std::integral<T>
+	friend auto
+	operator%=(SharedBigInt &a, const T &b) -> SharedBigInt& {
+		return a.mutate([&](BigInt &v) { v = BigInt{v % unwrap(b)}; }); // with an integer b, v % b is an integer
+	}
+
+	friend auto
+	operator<<=(SharedBigInt &a, uint64_t bits) -> SharedBigInt& {
+		return a.mutate([&](BigInt &v) { static_cast<void>(v <<= bits); });
+	}
+
+	friend auto
+	operator>>=(SharedBigInt &a, uint64_t bits) -> SharedBigInt& {
+		return a.mutate([&](BigInt &v) { static_cast<void>(v >>= bits); });
+	}
+
+	friend void
+	swap(SharedBigInt &a, SharedBigInt &b) noexcept {
+		std::swap(a._value, b._value);
+	}
+
+private:
+	std::shared_ptr<BigInt> _value; // never null, only modified while not shared
+
+	/**
+	 * @brief all default constructed values share one zero.
+	 */
+	static auto
+	zero() -> std::shared_ptr<BigInt> {
+		static const std::shared_ptr<BigInt> zero = make(BigInt{0});
+		return zero;
+	}
+
+	template <typename T>
+	static auto
+	make(T &&v) -> std::shared_ptr<BigInt> {
+		ScopedMemoryResource global{nullptr};
+		if constexpr (std::is_same_v<T, BigInt>) {
+			if (v.storage_resource() == nullptr) { // only digits from the global heap may be stolen
+				return std::make_shared<BigInt>(std::move(v));
+			}
+		}
+		return std::make_shared<BigInt>(std::as_const(v));
+	}
 
-		if(is_single_digit_division) {
-			x = BigIntAdapter2{yz_lo, yz_hi} - mult(e, d); // remainder is less than e, so must be single digit
+	/**
+	 * @brief a SharedBigInt operand is passed on as its BigInt, so that `a += a` is seen as aliased.
+	 */
+	template <typename T>
+	static auto
+	unwrap(const T &v) -> const auto& {
+		if constexpr (std::is_same_v<T, SharedBigInt>) {
+			return v.value();
 		} else {
-			d = _correct_d_and_subtract(x, b, d);
+			return v;
 		}
+	}
 
-		if constexpr (!ignore_quotient) {
-			qt.set(qt.size() - 1 - m + nb, d);
+	/**
+	 * @brief calls f with the value after detaching it from all other SharedBigInts.
+	 */
+	template <typename F>
+	auto
+	mutate(F &&f) -> SharedBigInt& {
+		ScopedMemoryResource global{nullptr};
+		if (_value.use_count() != 1) {
+			_value = std::make_shared<BigInt>(std::as_const(*_value));
+		} else {
+			std::atomic_thread_fence(std::memory_order_acquire); // pairs with the release of the last other owner
 		}
+		f(*_value);
+		return *this;
 	}
-	/* (loop-invariant P) AND (m=na) holds. */
-	/* Now x contains the remainder. */
+};
 
-	if constexpr (!ignore_quotient) {
-		qt.cleanup();
-	}
-	return {std::move(qt), std::move(x)};
 }
 
 
+// number theoretic transform:
+namespace bigint::_private {
+
+using utils::_private::uint128_t_;
+
 /**
- * @brief division algorithm adapted from Nitin Verma, 2021, Implementing Basic Arithmetic for Large Integers: Division
- *
- * @param aa the dividend
- * @param bb the divisor
- * @return the result
+ * @brief a prime p = c * 2^k + 1 < 2^62 together with everything needed for Montgomery multiplication modulo p (R = 2^64).
  */
-template <is_BigInt_like TLHS, is_BigInt_like TRHS, bool ignore_quotient = false, bool ignore_remainder = false>
-BIGINT_TRACY_CONSTEXPR_AUTO
-divmod_ignore_sign(const TLHS& aa, const TRHS& bb) -> DivModResult<BigInt> {
-	BIGINT_TRACY_ZONE_SCOPED;
+struct NttPrime {
+	consteval NttPrime(uint64_t p, uint64_t generator) noexcept
+		: p(p), p_inv_neg(0 - utils::inverse_mod_2_64(p)), r2(r2_mod(p)), generator(generator) {}
 
-	if (is_zero(bb)) {
-		throw std::domain_error{utils::error_msg("division by zero")};
+	uint64_t p;
+	uint64_t p_inv_neg; // -p^-1 mod 2^64
+	uint64_t r2;        // 2^128 mod p
+	uint64_t generator; // primitive root modulo p
+
+	/// x * y * 2^-64 mod p. Requires x * y < p * 2^64.
+	CONSTEXPR_AUTO
+	mont_mul(uint64_t x, uint64_t y) const noexcept -> uint64_t {
+		const uint128_t_ t = uint128_t_(x) * y;
+		const uint64_t m = uint64_t(t) * p_inv_neg;
+		const uint64_t r = uint64_t((t + uint128_t_(m) * p) >> 64);
+		return r >= p ? r - p : r;
 	}
-	if (is_zero(aa)) {
-		return {BigInt{0}, BigInt{0}};
+
+	/// x * 2^64 mod p, the Montgomery representation of x.
+	CONSTEXPR_AUTO
+	to_mont(uint64_t x) const noexcept -> uint64_t {
+		return mont_mul(x % p, r2);
 	}
-	if (bb.size() > aa.size()) {
-		if constexpr (!ignore_remainder) {
-			return {BigInt{0}, BigInt{aa}};
-		} else {
-			return {BigInt{0}, BigInt{1}}; // remainder could be any positive number. it is only used to signify that the remiander is non-zero.
-		}
+
+	CONSTEXPR_AUTO
+	add(uint64_t x, uint64_t y) const noexcept -> uint64_t {
+		const uint64_t r = x + y;
+		return r >= p ? r - p : r;
 	}
 
-	uint64_t e = bb[bb.size() - 1];
-	if((bb.size() > 1) && (e < 1ull<<63)) {
-		/* normalization */
-		uint64_t f = utils::div_u128_saturate(1ull, 0ull, e + 1); // 1^64/(e + 1);
-		const auto af = aa * f;
-		const auto bf = bb * f;
-		e = bf[bf.size() - 1];
-		auto result = _divide_loop<BigInt, _private::BigIntAbs<const BigInt&>, ignore_quotient, ignore_remainder>(af, abs(bf), e);
+	CONSTEXPR_AUTO
+	sub(uint64_t x, uint64_t y) const noexcept -> uint64_t {
+		return x >= y ? x - y : x + p - y;
+	}
 
-		if constexpr (!ignore_remainder) {
-			result.r = std::move(divmod_ignore_sign<BigInt, BigIntAdapter<uint64_t>, false, true>(result.r, BigIntAdapter{f}).d);
+	/// x^e in Montgomery representation, x must be in Montgomery representation as well.
+	CONSTEXPR_AUTO
+	mont_pow(uint64_t x, uint64_t e) const noexcept -> uint64_t {
+		uint64_t result = to_mont(1);
+		while (e != 0) {
+			if (e & 1) {
+				result = mont_mul(result, x);
+			}
+			x = mont_mul(x, x);
+			e >>= 1;
 		}
 		return result;
-	} else {
-		return _divide_loop<TLHS, _private::BigIntAbs<const TRHS&>, ignore_quotient, ignore_remainder>(aa, abs(bb), e);
 	}
-}
-
-
-template <is_BigInt_like TLHS, bool ignore_quotient = false, bool ignore_remainder = false>
-BIGINT_TRACY_CONSTEXPR_AUTO
-divmod_ignore_sign(const TLHS &a, const uint64_t &b) -> DivModResult<BigInt, uint64_t> {
-	const auto res = divmod_ignore_sign<TLHS, BigIntAdapter<uint64_t>, ignore_quotient, ignore_remainder>(a, BigIntAdapter{b});
-	return { res.d, res.r[0] };
-}
 
-}
+private:
+	static consteval uint64_t r2_mod(uint64_t p) {
+		const uint128_t_ r = ((uint128_t_(1) << 64) % p);
+		return uint64_t((r * r) % p);
+	}
+};
 
+/// three primes with 2^50 | p-1. Their product is larger than 2^185, so no coefficient of a convolution of up to 2^57 digits overflows.
+inline constexpr std::array<NttPrime, 3> ntt_primes {
+	NttPrime{4601552919265804289ull, 3},  // 4087 * 2^50 + 1
+	NttPrime{4546383823830515713ull, 10}, // 4038 * 2^50 + 1
+	NttPrime{4522739925786820609ull, 37}, // 4017 * 2^50 + 1
+};
 
-// divmod:
-namespace bigint {
 
-template <is_BigInt_like TLHS, is_BigInt_like TRHS, bool ignore_quotient = false, bool ignore_remainder = false>
+/**
+ * @brief the twiddle factors of all stages of a transform of size n in Montgomery representation.
+ *        For each stage of length 2h, twiddles[h + j] = w_2h^j for j < h, where w_2h is a primitive 2h-th root of unity modulo `prime`.
+ *        Storing every stage contiguously keeps the butterflies of large transforms cache friendly.
+ * @param inverse use the inverse roots w^-1 instead.
+ */
 BIGINT_TRACY_CONSTEXPR_AUTO
-divmod(const TLHS &a, const TRHS &b) -> DivModResult<BigInt> {
-	auto r = _private::divmod_ignore_sign<TLHS, TRHS, ignore_quotient, ignore_remainder>(a, b);
+ntt_twiddles(std::size_t n, const NttPrime &prime, bool inverse) -> std::vector<uint64_t> {
+	BIGINT_TRACY_ZONE_SCOPED;
+	std::vector<uint64_t> twiddles(std::max(n, std::size_t{2}));
+	uint64_t w = prime.mont_pow(prime.to_mont(prime.generator), (prime.p - 1) / n);
+	if (inverse) {
+		w = prime.mont_pow(w, n - 1);
+	}
+	const std::size_t half = n / 2;
+	twiddles[half] = prime.to_mont(1);
+	for (std::size_t j = 1; j < half; ++j) {
+		twiddles[half + j] = prime.mont_mul(twiddles[half + j - 1], w);
+	}
+	for (std::size_t h = half / 2; h > 0; h /= 2) {
+		for (std::size_t j = 0; j < h; ++j) {
+			twiddles[h + j] = twiddles[2 * h + 2 * j];
+		}
+	}
+	return twiddles;
+}
 
-	r.r.cleanup(); //r.r is also used by quotient.
-	if constexpr (!ignore_remainder) {
-		if (!is_zero(r.r)) {
-			if (is_neg(a)) {
-				r.r.sign() = Sign::NEG;
-			}
-			if (a.sign() != b.sign()) {
-				r.r += b;
+
+/**
+ * @brief in-place cyclic number theoretic transform of `data` modulo `prime` (decimation in frequency). data.size() must be a power of two.
+ *        The values in data are not in Montgomery representation, the twiddle factors are, so a transform preserves the representation.
+ *        The result is in bit reversed order, which ntt_inverse() expects as input.
+ * @param twiddles ntt_twiddles(data.size(), prime, false)
+ */
+BIGINT_TRACY_CONSTEXPR_VOID
+ntt_forward(std::vector<uint64_t> &data, const NttPrime &prime, const std::vector<uint64_t> &twiddles) {
+	BIGINT_TRACY_ZONE_SCOPED;
+	const std::size_t n = data.size();
+	for (std::size_t half = n / 2; half > 0; half /= 2) {
+		for (std::size_t i = 0; i < n; i += 2 * half) {
+			for (std::size_t j = 0; j < half; ++j) {
+				const uint64_t u = data[i + j];
+				const uint64_t v = data[i + j + half];
+				data[i + j] = prime.add(u, v);
+				data[i + j + half] = prime.mont_mul(prime.sub(u, v), twiddles[half + j]);
 			}
 		}
 	}
-	if constexpr (!ignore_quotient) {
-		r.d.sign() = _private::mult_sign(a.sign(), b.sign());
-		if (!is_zero(r.r) and r.d.sign() == Sign::NEG) {
-			r.d -= 1;
+}
+
+
+/**
+ * @brief inverse of ntt_forward() (decimation in time), taking bit reversed input and producing natural order.
+ *        The result is not scaled by 1/data.size().
+ * @param twiddles ntt_twiddles(data.size(), prime, true)
+ */
+BIGINT_TRACY_CONSTEXPR_VOID
+ntt_inverse(std::vector<uint64_t> &data, const NttPrime &prime, const std::vector<uint64_t> &twiddles) {
+	BIGINT_TRACY_ZONE_SCOPED;
+	const std::size_t n = data.size();
+	for (std::size_t half = 1; half < n; half *= 2) {
+		for (std::size_t i = 0; i < n; i += 2 * half) {
+			for (std::size_t j = 0; j < half; ++j) {
+				const uint64_t u = data[i + j];
+				const uint64_t v = prime.mont_mul(data[i + j + half], twiddles[half + j]);
+				data[i + j] = prime.add(u, v);
+				data[i + j + half] = prime.sub(u, v);
+			}
 		}
-		r.d.cleanup();
 	}
-	return r;
 }
 
-template <is_BigInt_like TLHS, bool ignore_quotient = false, bool ignore_remainder = false>
-BIGINT_TRACY_CONSTEXPR_AUTO
-divmod(const TLHS &a, int64_t b) -> DivModResult<BigInt, int64_t> {
-	const auto res = divmod<TLHS, BigIntAdapter<int64_t>, ignore_quotient, ignore_remainder>(a, BigIntAdapter{b});
 
-	if constexpr (ignore_remainder) {
-		return { res.d, 0 };
+/**
+ * @brief the cyclic convolution of the digits of a and b modulo `prime`. The result has `n` elements.
+ *        If a and b are the same object, only one operand is transformed.
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+ntt_convolution(const TLHS &a, const TRHS &b, std::size_t n, const NttPrime &prime) -> std::vector<uint64_t> {
+	BIGINT_TRACY_ZONE_SCOPED;
+	std::vector<uint64_t> fa(n, 0);
+	for (std::size_t i = 0; i < a.size(); ++i) {
+		fa[i] = a[i] % prime.p;
+	}
+	const auto twiddles = ntt_twiddles(n, prime, false);
+	ntt_forward(fa, prime, twiddles);
+	if (static_cast<const void*>(&a) == static_cast<const void*>(&b)) {
+		// squaring: one forward transform is enough.
+		for (auto& x : fa) {
+			x = prime.mont_mul(x, x);
+		}
 	} else {
-		int64_t r = (int64_t)res.r[0];
-		if (is_neg(res.r)) {
-			r = -r;
+		std::vector<uint64_t> fb(n, 0);
+		for (std::size_t i = 0; i < b.size(); ++i) {
+			fb[i] = b[i] % prime.p;
 		}
-		return { res.d, r };
+		ntt_forward(fb, prime, twiddles);
+		for (std::size_t i = 0; i < n; ++i) {
+			fa[i] = prime.mont_mul(fa[i], fb[i]); // = fa[i] * fb[i] * 2^-64
+		}
+	}
+	ntt_inverse(fa, prime, ntt_twiddles(n, prime, true));
+
+	// scale by 2^64 / n to undo the Montgomery factor from the pointwise multiplication and the missing 1/n of the inverse transform.
+	const uint64_t n_inv = prime.p - (prime.p - 1) / n;
+	const uint64_t scale = prime.mont_mul(prime.mont_mul(n_inv, prime.r2), prime.r2); // n^-1 * 2^128
+	for (auto& x : fa) {
+		x = prime.mont_mul(x, scale);
 	}
+	return fa;
 }
 
-template <is_BigInt_like TLHS, bool ignore_quotient = false, bool ignore_remainder = false>
-BIGINT_TRACY_CONSTEXPR_AUTO
-divmod(const TLHS &a, uint64_t b) -> DivModResult<BigInt, uint64_t> {
-	const auto res = divmod<TLHS, BigIntAdapter<uint64_t>, ignore_quotient, ignore_remainder>(a, BigIntAdapter{b});
-	return { res.d, res.r[0] };
+
+/**
+ * @brief combines the residues of one coefficient modulo the three ntt_primes into the coefficient (Garner's algorithm).
+ * @return the coefficient as three digits, least significant first.
+ */
+CONSTEXPR_AUTO
+ntt_crt(uint64_t r0, uint64_t r1, uint64_t r2) -> std::array<uint64_t, 3> {
+	constexpr const NttPrime &q1 = ntt_primes[1];
+	constexpr const NttPrime &q2 = ntt_primes[2];
+	constexpr uint64_t p0 = ntt_primes[0].p;
+	constexpr uint128_t_ p0p1 = uint128_t_(p0) * q1.p;
+	// the constants are in Montgomery representation, so one mont_mul() is a plain modular multiplication.
+	constexpr uint64_t p0_inv_mod_p1 = q1.mont_pow(q1.to_mont(p0), q1.p - 2);
+	constexpr uint64_t p0_mod_p2 = q2.to_mont(p0);
+	constexpr uint64_t p0p1_inv_mod_p2 = q2.mont_pow(q2.to_mont(uint64_t(p0p1 % q2.p)), q2.p - 2);
+
+	// x = r0 + p0 * v1 + p0 * p1 * v2. p0 > p1 > p2 and p0 < 2 * p2, so a single subtraction reduces r0.
+	const uint64_t v1 = q1.mont_mul(q1.sub(r1, r0 >= q1.p ? r0 - q1.p : r0), p0_inv_mod_p1);
+	const uint64_t x01_mod_p2 = q2.add(r0 >= q2.p ? r0 - q2.p : r0, q2.mont_mul(v1, p0_mod_p2));
+	const uint64_t v2 = q2.mont_mul(q2.sub(r2, x01_mod_p2), p0p1_inv_mod_p2);
+	const uint128_t_ x01 = uint128_t_(p0) * v1 + r0;
+
+	// (hi, lo) = p0 * p1 * v2
+	const uint128_t_ lo = uint128_t_(uint64_t(p0p1)) * v2;
+	const uint128_t_ hi = uint128_t_(uint64_t(p0p1 >> 64)) * v2 + (lo >> 64);
+	const uint128_t_ sum_lo = uint128_t_(uint64_t(lo)) + uint64_t(x01);
+	const uint128_t_ sum_mid = uint128_t_(uint64_t(hi)) + uint64_t(x01 >> 64) + (sum_lo >> 64);
+	const uint64_t sum_hi = uint64_t(hi >> 64) + uint64_t(sum_mid >> 64);
+	return { uint64_t(sum_lo), uint64_t(sum_mid), sum_hi };
 }
 
-template <is_BigInt_like TLHS, bool ignore_quotient = false, bool ignore_remainder = false>
+}
+
+
+// multiplication algorithms:
+namespace bigint::_private {
+
+/**
+ * @brief schoolbook multiplication. Accumulates one row a * b[i] per digit of the shorter operand b,
+ *        each one a single pass of addmul_1() over the result.
+ * @return abs(a) * abs(b)
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
 BIGINT_TRACY_CONSTEXPR_AUTO
-divmod1(const TLHS &a, uint32_t b) -> DivModResult<BigInt, uint32_t> {
+mult_schoolbook(const TLHS &a, const TRHS &b) -> BigInt {
 	BIGINT_TRACY_ZONE_SCOPED;
-	if (b == 0) {
-		throw std::domain_error{utils::error_msg("division by zero")};
+	if (a.size() < b.size()) {
+		return mult_schoolbook(b, a);
 	}
-	if (is_zero(a)) {
-		return {BigInt{0}, 0};
+	const auto na = a.size();
+	BigInt result;
+	result.resize(na + b.size());
+
+	const auto r = result.digits();
+	for (std::size_t i = 0; i < b.size(); ++i) {
+		r[i + na] = addmul_1(result, i, a, na, b[i]);
 	}
+	result.cleanup();
+	return result;
+}
 
-	BigInt q;
-	if constexpr (!ignore_quotient) {
-		q.resize(a.size());
+
+/**
+ * @brief Karatsuba multiplication. Splits the longer operand at k = a.size() / 2 into a = a1 * 2^(64k) + a0 (and b likewise)
+ *        and calculates a * b = z2 * 2^(128k) + z1 * 2^(64k) + z0 using only three recursive multiplications:
+ *        z0 = a0 * b0, z2 = a1 * b1, z1 = (a0 + a1) * (b0 + b1) - z0 - z2.
+ *        The halves are views into the operands, so no digits are copied.
+ * @return abs(a) * abs(b)
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+mult_karatsuba(const TLHS &a, const TRHS &b) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	if (a.size() < b.size()) {
+		return mult_karatsuba(b, a);
 	}
+	const auto na = a.size();
+	const auto nb = b.size();
+	const auto k = na / 2;
 
-	// y = q * b; but not always.
-	BigInt y{0, a.sign()};
-	if constexpr (!ignore_remainder) {
-		y.resize(a.size() + 1);
+	const auto a0 = sliced(a, 0, k);
+	const auto a1 = sliced(a, k, na - k);
+
+	BigInt result;
+	result.resize(na + nb);
+
+	if (nb <= k) {
+		// b is too short to be split; only split a.
+		const auto z0 = mult_ignore_sign(a0, b);
+		const auto z1 = mult_ignore_sign(a1, b);
+		add_ignore_sign(result, result, z0);
+		const auto z1_shifted = lshifted(z1, k);
+		add_ignore_sign(result, result, z1_shifted);
+	} else {
+		const auto b0 = sliced(b, 0, k);
+		const auto b1 = sliced(b, k, nb - k);
+
+		const BigInt a01 = a0 + a1;
+		const BigInt b01 = b0 + b1;
+		auto [z0, z2, z1] = parallel_invoke(nb,
+			[&]() { return mult_ignore_sign(a0, b0); },
+			[&]() { return mult_ignore_sign(a1, b1); },
+			[&]() { return mult_ignore_sign(a01, b01); }
+		);
+		z1 -= z0;
+		z1 -= z2;
+
+		add_ignore_sign(result, result, z0);
+		const auto z1_shifted = lshifted(z1, k);
+		add_ignore_sign(result, result, z1_shifted);
+		const auto z2_shifted = lshifted(z2, 2 * k);
+		add_ignore_sign(result, result, z2_shifted);
 	}
+	result.cleanup();
+	return result;
+}
 
-	uint64_t c_div = 0ull;
-	uint64_t di_hi = 0ull;
-	uint64_t ai_lo = 0ull;
 
-	size_t i = a.size() + 1;
-	bool is_first_iter = true;
-	while (i > 0) {
-		--i;
-		uint64_t di = 0;
-		if (!is_first_iter) {
-			const auto di_lo = ai_lo / b;
-			c_div = (ai_lo % b) << 32; // ???
-			di = (di_hi << 32) | di_lo;
+/**
+ * @brief adds coefficients[i] * 2^(64 * i * k) to result for all i. All coefficients must be non-negative.
+ */
+template <is_BigInt_like TRES, std::size_t N>
+BIGINT_TRACY_CONSTEXPR_VOID
+_recompose_coefficients(TRES &result, const std::array<BigInt, N> &coefficients, std::size_t k) {
+	for (std::size_t i = 0; i < N; ++i) {
+		const auto shifted = lshifted(coefficients[i], i * k);
+		add_ignore_sign(result, result, shifted);
+	}
+}
 
-			if constexpr (!ignore_quotient) {
-				q.set(i, di);
-			}
-		}
 
-		const auto ai = (i != 0) ? a[i-1]: 0;
-		const auto ai_hi = (i != 0) ? (ai >> 32) | c_div : 0;
-				   di_hi = ai_hi / b;
-		const auto c_diw = (ai_hi % b) << 32;
-				   ai_lo = (ai & 0xFFFFFFFFull) | c_diw;
+/**
+ * @brief evaluates x0 + x1 * t + x2 * t^2 at the points 1, -1, and -2 for Toom-Cook 3-way.
+ */
+template <is_BigInt_like T0, is_BigInt_like T1, is_BigInt_like T2>
+BIGINT_TRACY_CONSTEXPR_AUTO
+_toom3_evaluate(const T0 &x0, const T1 &x1, const T2 &x2) -> std::array<BigInt, 3> {
+	const BigInt x02 = x0 + x2;
+	const BigInt xm1 = x02 - x1;
+	return {
+		x02 + x1,                  // x(1)
+		xm1,                       // x(-1)
+		((xm1 + x2) << 1) - x0,    // x(-2)
+	};
+}
 
-		if constexpr (!ignore_remainder) {
-			const uint32_t c_ = di_hi >> 32;
-			const auto ji = di + c_;
-			const auto yi = ji*b; // todo: investigate why doesn't this overflow ??
-			y.set(i, yi);
-		}
 
-		is_first_iter = false;
-	}
+/**
+ * @brief turns the values r(0), r(1), r(-1), r(-2), r(inf) of the product polynomial into its coefficients (in-place),
+ *        using Marco Bodrato's sequence. The divisions are exact.
+ */
+BIGINT_TRACY_CONSTEXPR_VOID
+_toom3_interpolate(std::array<BigInt, 5> &r) {
+	r[3] -= r[1];
+	r[3] /= 3u;
+	r[1] -= r[2];
+	r[1] = r[1] >> 1;
+	r[2] -= r[0];
+	r[3] = ((r[2] - r[3]) >> 1) + (r[4] << 1);
+	r[2] += r[1];
+	r[2] -= r[4];
+	r[1] -= r[3];
+}
 
 
-	if constexpr (!ignore_quotient) {
-		q.sign() = _private::mult_sign(a.sign(), Sign::POS);
-		if (c_div != 0 && q.sign() == Sign::NEG) {
-			q -= 1;
-		}
-		q.cleanup();
+/**
+ * @brief Toom-Cook 3-way multiplication. Splits the operands into three parts of k digits each, evaluates the resulting
+ *        polynomials at the points 0, 1, -1, -2, and infinity, multiplies the five values recursively, and interpolates
+ *        the product using Marco Bodrato's sequence. The divisions during interpolation are exact.
+ * @return abs(a) * abs(b)
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+mult_toom3(const TLHS &a, const TRHS &b) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	if (a.size() < b.size()) {
+		return mult_toom3(b, a);
 	}
-
-	if constexpr (ignore_remainder) {
-		return { q, 0 };
-	} else {
-		y.cleanup();
-		BigInt r_big = a - y;
-		uint32_t r = (uint32_t) r_big[0];
-		if (r != 0 && is_neg(a)) {
-			r = b - r;
-		}
-		return { q, r };
+	const auto na = a.size();
+	const auto nb = b.size();
+	const auto k = (na + 2) / 3;
+	if (nb <= 2 * k) {
+		// b does not have three parts.
+		return mult_karatsuba(a, b);
 	}
+
+	const auto a0 = sliced(a, 0, k);
+	const auto a1 = sliced(a, k, k);
+	const auto a2 = sliced(a, 2 * k, na - 2 * k);
+	const auto b0 = sliced(b, 0, k);
+	const auto b1 = sliced(b, k, k);
+	const auto b2 = sliced(b, 2 * k, nb - 2 * k);
+
+	const auto av = _toom3_evaluate(a0, a1, a2);
+	const auto bv = _toom3_evaluate(b0, b1, b2);
+
+	// pointwise multiplication:
+	auto r = parallel_invoke(nb,
+		[&]() { return mult_ignore_sign(a0, b0); }, // r(0)
+		[&]() { return mult_ignore_sign(av[0], bv[0]); }, // r(1)
+		[&]() { return mult(av[1], bv[1]); }, // r(-1)
+		[&]() { return mult(av[2], bv[2]); }, // r(-2)
+		[&]() { return mult_ignore_sign(a2, b2); } // r(inf)
+	);
+
+	_toom3_interpolate(r);
+
+	BigInt result;
+	result.resize(na + nb);
+	_recompose_coefficients(result, r, k);
+	result.cleanup();
+	return result;
+}
+
+
+/**
+ * @brief evaluates x0 + x1 * t + x2 * t^2 + x3 * t^3 at the points -2, 1, -1, 2, and (scaled by 8) 1/2 for Toom-Cook 4-way.
+ */
+template <is_BigInt_like T0, is_BigInt_like T1, is_BigInt_like T2, is_BigInt_like T3>
+BIGINT_TRACY_CONSTEXPR_AUTO
+_toom4_evaluate(const T0 &x0, const T1 &x1, const T2 &x2, const T3 &x3) -> std::array<BigInt, 5> {
+	const BigInt x02 = x0 + x2;
+	const BigInt x13 = x1 + x3;
+	const BigInt x0_4x2 = x0 + (x2 << 2);
+	const BigInt x1_4x3 = (x1 + (x3 << 2)) << 1;
+	return {
+		x0_4x2 - x1_4x3,                           // x(-2)
+		x02 + x13,                                 // x(1)
+		x02 - x13,                                 // x(-1)
+		x0_4x2 + x1_4x3,                           // x(2)
+		(((((x0 << 1) + x1) << 1) + x2) << 1) + x3 // 8 * x(1/2)
+	};
+}
+
+
+/**
+ * @brief turns the values w(0), w(-2), w(1), w(-1), w(2), 64 * w(1/2), w(inf) of the product polynomial into its
+ *        coefficients (in-place), using Marco Bodrato's sequence. The divisions are exact.
+ */
+BIGINT_TRACY_CONSTEXPR_VOID
+_toom4_interpolate(std::array<BigInt, 7> &w) {
+	w[5] += w[4];
+	w[1] = (w[4] - w[1]) >> 1;
+	w[4] -= w[0];
+	w[4] = ((w[4] - w[1]) >> 2) - (w[6] << 4);
+	w[3] = (w[2] - w[3]) >> 1;
+	w[2] -= w[3];
+
+	w[5] -= w[2] * 65u;
+	w[2] -= w[6];
+	w[2] -= w[0];
+	w[5] = (w[5] + w[2] * 45u) >> 1;
+	w[4] -= w[2];
+	w[4] /= 3u;
+	w[2] -= w[4];
+
+	w[1] = w[5] - w[1];
+	w[5] -= w[3] << 3;
+	w[5] /= 9u;
+	w[3] -= w[5];
+	w[1] /= 15u;
+	w[1] = (w[1] + w[5]) >> 1;
+	w[5] -= w[1];
 }
 
-template <is_BigInt_like TLHS, bool ignore_quotient = false, bool ignore_remainder = false>
+
+/**
+ * @brief Toom-Cook 4-way multiplication. Splits the operands into four parts of k digits each, evaluates the resulting
+ *        polynomials at the points 0, 1, -1, 2, -2, 1/2, and infinity, multiplies the seven values recursively,
+ *        and interpolates the product using Marco Bodrato's sequence. The divisions during interpolation are exact.
+ * @return abs(a) * abs(b)
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
 BIGINT_TRACY_CONSTEXPR_AUTO
-divmod1(const TLHS &a, int32_t bb) -> DivModResult<BigInt, int32_t> {
-	if (bb < 0) {
-		auto r = divmod1<_private::BigIntNeg<const TLHS&>, ignore_quotient, ignore_remainder>(-a, (uint32_t) -bb);
-		return DivModResult{std::move(r.d), -(int32_t)r.r};
-	} else {
-		auto r = divmod1<TLHS, ignore_quotient, ignore_remainder>(a, (uint32_t) bb);
-		return DivModResult{std::move(r.d), (int32_t)r.r};
+mult_toom4(const TLHS &a, const TRHS &b) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	if (a.size() < b.size()) {
+		return mult_toom4(b, a);
 	}
-}
+	const auto na = a.size();
+	const auto nb = b.size();
+	const auto k = (na + 3) / 4;
+	if (nb <= 3 * k) {
+		// b does not have four parts.
+		return mult_toom3(a, b);
+	}
+
+	const auto a0 = sliced(a, 0, k);
+	const auto a1 = sliced(a, k, k);
+	const auto a2 = sliced(a, 2 * k, k);
+	const auto a3 = sliced(a, 3 * k, na - 3 * k);
+	const auto b0 = sliced(b, 0, k);
+	const auto b1 = sliced(b, k, k);
+	const auto b2 = sliced(b, 2 * k, k);
+	const auto b3 = sliced(b, 3 * k, nb - 3 * k);
+
+	const auto av = _toom4_evaluate(a0, a1, a2, a3);
+	const auto bv = _toom4_evaluate(b0, b1, b2, b3);
+
+	// pointwise multiplication:
+	auto w = parallel_invoke(nb,
+		[&]() { return mult_ignore_sign(a0, b0); }, // w(0)
+		[&]() { return mult(av[0], bv[0]); }, // w(-2)
+		[&]() { return mult_ignore_sign(av[1], bv[1]); }, // w(1)
+		[&]() { return mult(av[2], bv[2]); }, // w(-1)
+		[&]() { return mult_ignore_sign(av[3], bv[3]); }, // w(2)
+		[&]() { return mult_ignore_sign(av[4], bv[4]); }, // 64 * w(1/2)
+		[&]() { return mult_ignore_sign(a3, b3); } // w(inf)
+	);
+
+	_toom4_interpolate(w);
 
+	BigInt result;
+	result.resize(na + nb);
+	_recompose_coefficients(result, w, k);
+	result.cleanup();
+	return result;
 }
 
 
-// division:
-namespace bigint {
-
-template <is_BigInt_like TLHS>
-BIGINT_TRACY_CONSTEXPR_VOID
-div(BigInt &result, TLHS &a, uint32_t b) {
+/**
+ * @brief multiplication using number theoretic transforms modulo three primes and the chinese remainder theorem.
+ *        O(n log n) multiplications per prime, best for very large operands.
+ * @return abs(a) * abs(b)
+ */
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+BIGINT_TRACY_CONSTEXPR_AUTO
+mult_ntt(const TLHS &a, const TRHS &b) -> BigInt {
 	BIGINT_TRACY_ZONE_SCOPED;
-	if (b == 0) {
-		throw std::domain_error{utils::error_msg("division by zero")};
-	}
-	if (is_zero(a)) {
-		result = BigInt{0};
+	const std::size_t na = a.size();
+	const std::size_t nb = b.size();
+	std::size_t n = 1;
+	while (n < na + nb - 1) {
+		n <<= 1;
 	}
-	uint64_t c_lo = 0ull;
-	for (auto i = a.size(); i-->0;) {
-		const auto ai = a[i];
-		const auto ai_hi = (ai >> 32) | c_lo;
-		const auto r_hi = ai_hi / b;
-		const auto c_hi = (ai_hi % b) << 32;
 
-		const auto ai_lo = (ai & 0xFFFFFFFFull) | c_hi;
-		const auto r_lo = ai_lo / b;
-		c_lo = (ai_lo % b) << 32;
-		const auto r = (r_hi << 32) | r_lo;
-		result.set(i, r);
-	}
-	result.sign() = a.sign();
-	if (c_lo != 0 && result.sign() == Sign::NEG) {
-		result -= 1;
-	}
-}
+	const auto [c0, c1, c2] = parallel_invoke(std::min(na, nb),
+		[&]() { return ntt_convolution(a, b, n, ntt_primes[0]); },
+		[&]() { return ntt_convolution(a, b, n, ntt_primes[1]); },
+		[&]() { return ntt_convolution(a, b, n, ntt_primes[2]); }
+	);
 
-template <is_BigInt_like TLHS>
-BIGINT_TRACY_CONSTEXPR_VOID
-div(BigInt &result, TLHS &a, int32_t bb) {
-	if (bb < 0) {
-		auto neg_a = -a; // todo check undefined behavior with -a if result === a, because operator-() const-ifys a?
-		div(result, neg_a, (uint32_t) -bb);
-	} else {
-		div(result, a, (uint32_t) bb);
+	BigInt result;
+	result.resize(na + nb);
+	const auto r = result.digits();
+	std::array<uint64_t, 3> carry{ 0, 0, 0 };
+	for (std::size_t i = 0; i < na + nb; ++i) {
+		if (i < na + nb - 1) {
+			const auto coefficient = ntt_crt(c0[i], c1[i], c2[i]);
+			uint8_t c = 0;
+			for (std::size_t j = 0; j < 3; ++j) {
+				carry[j] = utils::add_carry(carry[j], coefficient[j], c);
+			}
+		}
+		r[i] = carry[0];
+		carry = { carry[1], carry[2], 0 };
 	}
+	result.cleanup();
+	return result;
 }
 
 
-template <is_BigInt_like TLHS, one_of<uint32_t, int32_t> TRHS>
+/**
+ * @brief schoolbook squaring. Every product a[i] * a[j] with i != j occurs twice in a^2, so only the products with i < j
+ *        are calculated, the sum is doubled, and the squares a[i]^2 are added. That is about half the digit products of mult_schoolbook().
+ * @return abs(a)^2
+ */
+template <is_BigInt_like T>
 BIGINT_TRACY_CONSTEXPR_AUTO
-operator/(const TLHS &a, TRHS b) -> BigInt {
+square_schoolbook(const T &a) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	const auto n = a.size();
 	BigInt result;
-	result.resize(a.size());
-	div(result, const_cast<TLHS&>(a), b);
+	result.resize(2 * n);
+	const auto r = result.digits();
+
+	// sum of a[i] * a[j] * 2^(64 * (i + j)) for i < j
+	for (std::size_t i = 0; i + 1 < n; ++i) {
+		r[i + n] = addmul_1(result, 2 * i + 1, rshifted(a, i + 1), n - i - 1, a[i]);
+	}
+
+	// double it, the sum is less than 2^(128n - 1), so no bit is lost.
+	kernels::lshift(r.data(), r.data(), 2 * n, 1);
+
+	// add the squares a[i]^2 * 2^(128 * i)
+	uint8_t c = 0; // carry
+	for (std::size_t i = 0; i < n; ++i) {
+		uint64_t hi;
+		const auto lo = utils::mult_u128(a[i], a[i], hi);
+		r[2 * i] = utils::add_carry(r[2 * i], lo, c);
+		r[2 * i + 1] = utils::add_carry(r[2 * i + 1], hi, c);
+	}
 	result.cleanup();
 	return result;
 }
 
-template <is_BigInt_like TLHS, one_of<uint64_t, int64_t> TRHS>
-BIGINT_TRACY_CONSTEXPR_AUTO
-operator/(const TLHS &a, TRHS b) -> BigInt {
-	return divmod<TLHS, BigIntAdapter<TRHS>, false, true>(a, BigIntAdapter(b)).d;
-}
 
-template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+/**
+ * @brief Karatsuba squaring: a^2 = z2 * 2^(128k) + z1 * 2^(64k) + z0 with z0 = a0^2, z2 = a1^2, z1 = (a0 + a1)^2 - z0 - z2.
+ * @return abs(a)^2
+ */
+template <is_BigInt_like T>
 BIGINT_TRACY_CONSTEXPR_AUTO
-operator/(const TLHS &a, const TRHS &b) -> BigInt {
-	return divmod<TLHS, TRHS, false, true>(a, b).d;
-}
-
+square_karatsuba(const T &a) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	const auto n = a.size();
+	const auto k = n / 2;
+	const auto a0 = sliced(a, 0, k);
+	const auto a1 = sliced(a, k, n - k);
+
+	const BigInt a01 = a0 + a1;
+	auto [z0, z2, z1] = parallel_invoke(n,
+		[&]() { return square_ignore_sign(a0); },
+		[&]() { return square_ignore_sign(a1); },
+		[&]() { return square_ignore_sign(a01); }
+	);
+	z1 -= z0;
+	z1 -= z2;
 
-template <one_of<uint32_t, int32_t> TRHS>
-BIGINT_TRACY_CONSTEXPR_AUTO_DISCARD
-operator/=(BigInt &a, TRHS b) -> BigInt& {
-	div(a, a, b);
-	a.cleanup();
-	return a;
+	BigInt result;
+	result.resize(2 * n);
+	add_ignore_sign(result, result, z0);
+	const auto z1_shifted = lshifted(z1, k);
+	add_ignore_sign(result, result, z1_shifted);
+	const auto z2_shifted = lshifted(z2, 2 * k);
+	add_ignore_sign(result, result, z2_shifted);
+	result.cleanup();
+	return result;
 }
 
-template <one_of<uint64_t, int64_t> TRHS>
-BIGINT_TRACY_CONSTEXPR_AUTO_DISCARD
-operator/=(BigInt &a, TRHS b) -> BigInt& {
-	const auto result = divmod<BigInt, BigIntAdapter<TRHS>, false, true>(a, BigIntAdapter(b)).d;
-	a = std::move(result);
-	return a;
-}
 
-template <is_BigInt_like TRHS>
-BIGINT_TRACY_CONSTEXPR_AUTO_DISCARD
-operator/=(BigInt &a, const TRHS &b) -> BigInt& {
-	const auto result = divmod<BigInt, TRHS, false, true>(a, b).d;
-	a = std::move(result);
-	return a;
-}
+/**
+ * @brief Toom-Cook 3-way squaring, see mult_toom3(). The operand is only evaluated once and all five products are squares.
+ * @return abs(a)^2
+ */
+template <is_BigInt_like T>
+BIGINT_TRACY_CONSTEXPR_AUTO
+square_toom3(const T &a) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	const auto n = a.size();
+	const auto k = (n + 2) / 3;
+	if (n <= 2 * k) {
+		return square_karatsuba(a);
+	}
+	const auto a0 = sliced(a, 0, k);
+	const auto a1 = sliced(a, k, k);
+	const auto a2 = sliced(a, 2 * k, n - 2 * k);
+	const auto av = _toom3_evaluate(a0, a1, a2);
+
+	auto r = parallel_invoke(n,
+		[&]() { return square_ignore_sign(a0); },
+		[&]() { return square_ignore_sign(av[0]); },
+		[&]() { return square_ignore_sign(av[1]); },
+		[&]() { return square_ignore_sign(av[2]); },
+		[&]() { return square_ignore_sign(a2); }
+	);
+	_toom3_interpolate(r);
 
+	BigInt result;
+	result.resize(2 * n);
+	_recompose_coefficients(result, r, k);
+	result.cleanup();
+	return result;
 }
 
 
-// Modulo:
-namespace bigint {
-
-template <is_BigInt_like TLHS, one_of<uint32_t, int32_t> TRHS>
+/**
+ * @brief Toom-Cook 4-way squaring, see mult_toom4(). The operand is only evaluated once and all seven products are squares.
+ * @return abs(a)^2
+ */
+template <is_BigInt_like T>
 BIGINT_TRACY_CONSTEXPR_AUTO
-operator%(const TLHS &a, TRHS b) -> TRHS {
-	return divmod1<TLHS, true>(a, b).r; // we can trunccate safely because the divisor only also is uint32_t.
+square_toom4(const T &a) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	const auto n = a.size();
+	const auto k = (n + 3) / 4;
+	if (n <= 3 * k) {
+		return square_toom3(a);
+	}
+	const auto a0 = sliced(a, 0, k);
+	const auto a1 = sliced(a, k, k);
+	const auto a2 = sliced(a, 2 * k, k);
+	const auto a3 = sliced(a, 3 * k, n - 3 * k);
+	const auto av = _toom4_evaluate(a0, a1, a2, a3);
+
+	auto w = parallel_invoke(n,
+		[&]() { return square_ignore_sign(a0); },
+		[&]() { return square_ignore_sign(av[0]); },
+		[&]() { return square_ignore_sign(av[1]); },
+		[&]() { return square_ignore_sign(av[2]); },
+		[&]() { return square_ignore_sign(av[3]); },
+		[&]() { return square_ignore_sign(av[4]); },
+		[&]() { return square_ignore_sign(a3); }
+	);
+	_toom4_interpolate(w);
+
+	BigInt result;
+	result.resize(2 * n);
+	_recompose_coefficients(result, w, k);
+	result.cleanup();
+	return result;
 }
 
-template <is_BigInt_like TLHS, one_of<uint64_t, int64_t> TRHS>
+
+/**
+ * @brief squares abs(a), selecting the algorithm based on its size. Uses the same thresholds as mult_ignore_sign().
+ * @return abs(a)^2
+ */
+template <is_BigInt_like T>
 BIGINT_TRACY_CONSTEXPR_AUTO
-operator%(const TLHS &a, TRHS b) -> TRHS {
-	return divmod<TLHS, true>(a, b).r;
+square_ignore_sign(const T &a) -> BigInt {
+	const auto tuning = current_tuning();
+	const auto n = a.size();
+	if (n < std::max(tuning.karatsuba_threshold, std::size_t{2})) {
+		return square_schoolbook(a);
+	} else if (n < tuning.toom3_threshold) {
+		return square_karatsuba(a);
+	} else if (n < tuning.toom4_threshold) {
+		return square_toom3(a);
+	} else if (n < tuning.ntt_threshold) {
+		return square_toom4(a);
+	} else {
+		return mult_ntt(a, a);
+	}
 }
 
+
+/**
+ * @brief multiplication of operands with very different sizes. Slices the longer operand into chunks the size of
+ *        the shorter one, multiplies every chunk with the balanced algorithms, and adds each product to the result
+ *        right away, so the result is only passed over about twice and no chunk is padded with zeros.
+ * @return abs(a) * abs(b)
+ */
 template <is_BigInt_like TLHS, is_BigInt_like TRHS>
 BIGINT_TRACY_CONSTEXPR_AUTO
-operator%(const TLHS &a, const TRHS &b) -> BigInt {
-	return divmod<TLHS, TRHS, true>(a, b).r;
+mult_unbalanced(const TLHS &a, const TRHS &b) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	if (a.size() < b.size()) {
+		return mult_unbalanced(b, a);
+	}
+	const auto na = a.size();
+	const auto nb = b.size();
+	BigInt result;
+	result.resize(na + nb);
+
+	const auto accumulate = [&](const BigInt &product, std::size_t start) {
+		// the products of neighbouring chunks overlap by nb digits.
+		auto carry = add_n(result, start, product, product.size());
+		for (auto i = start + product.size(); carry != 0; ++i) {
+			result.set(i, result[i] + 1);
+			carry = result[i] == 0 ? 1 : 0;
+		}
+	};
+	const auto chunk_product = [&](std::size_t start) {
+		return mult_ignore_sign(sliced(a, start, std::min(nb, na - start)), b);
+	};
+
+	const auto chunks = (na + nb - 1) / nb;
+	if (use_parallel(na)) {
+		// all chunk products are kept until the threads are done, then accumulated.
+		std::vector<BigInt> products(chunks);
+		parallel_for(na, chunks, [&](std::size_t i) { products[i] = chunk_product(i * nb); });
+		for (std::size_t i = 0; i < chunks; ++i) {
+			accumulate(products[i], i * nb);
+		}
+	} else {
+		for (std::size_t i = 0; i < chunks; ++i) {
+			accumulate(chunk_product(i * nb), i * nb);
+		}
+	}
+	result.cleanup();
+	return result;
 }
 
+
+/**
+ * @brief multiplies abs(a) and abs(b), selecting the algorithm based on the size of the operands.
+ *        Below the NTT threshold, operands at least twice as long as the other one are split by mult_unbalanced() first.
+ * @return abs(a) * abs(b)
+ */
 template <is_BigInt_like TLHS, is_BigInt_like TRHS>
 BIGINT_TRACY_CONSTEXPR_AUTO
-operator%=(TLHS &a, const TRHS &b) -> BigInt& {
-	const auto result = divmod<TLHS, TRHS, true>(a, b).r;
-	a = std::move(result);
-	return a;
+mult_ignore_sign(const TLHS &a, const TRHS &b) -> BigInt {
+	const auto tuning = current_tuning();
+	const auto n = std::min(a.size(), b.size());
+	if (n < std::max(tuning.karatsuba_threshold, std::size_t{2})) {
+		// schoolbook multiplication handles any ratio of sizes without overhead.
+		return mult_schoolbook(a, b);
+	} else if (n < tuning.ntt_threshold && std::max(a.size(), b.size()) >= 2 * n) {
+		// the cost of the transforms only depends on the total size, so mult_ntt() is not split.
+		return mult_unbalanced(a, b);
+	} else if (n < tuning.toom3_threshold) {
+		return mult_karatsuba(a, b);
+	} else if (n < tuning.toom4_threshold) {
+		return mult_toom3(a, b);
+	} else if (n < tuning.ntt_threshold) {
+		return mult_toom4(a, b);
+	} else {
+		return mult_ntt(a, b);
+	}
 }
 
 }
@@ -1914,11 +5597,11 @@ calculate_squares(const BASE& base, const T& y) -> std::vector<BigInt> {
 	std::vector<BigInt> squares;
 	squares.push_back(base);
 	for (uint8_t i = 1; i < exp_bits_max; ++i) {
-		auto square = squares.back() * squares.back();
-		if (square > y) {
+		auto next = square(squares.back());
+		if (next > y) {
 			break;
 		}
-		squares.emplace_back(std::move(square));
+		squares.emplace_back(std::move(next));
 	}
 	return squares;
 }
@@ -2030,7 +5713,7 @@ pow(const BASE& base, uint64_t exp) -> BigInt {
 			result *= temp;
 		}
 		if (i+1 < exp_bits) {
-			temp = temp * temp;
+			temp = square(temp);
 		}
 	}
 	return result;
@@ -2065,20 +5748,52 @@ pow_mod(const BASE& base, const EXP& exp, const MOD& mod) -> BigInt {
 		return BigInt{0};
 	}
 
-	const uint64_t exp_bits = (exp.size() - 1) * 64 + (64 - utils::clzll(exp[exp.size()-1]));
+	// Montgomery multiplication needs no division, but it is quadratic, so the fast multiplications of Barrett reduction win for huge moduli.
+	if (mod[0] % 2 == 1 && mod.size() < _private::current_tuning().montgomery_threshold) {
+		return pow_mod(base, exp, MontgomeryContext{mod});
+	}
+	return pow_mod(base, exp, BarrettReducer{mod});
+}
 
-	BigInt result{1};
-	auto temp = base % mod;
-	for (uint64_t i = 0; i < exp_bits; ++i) {
-		const auto mask = 1ull << (i % 64);
-		if (exp[i/64] & mask) {
-			result = (result * temp) % mod;
+/**
+ * @brief raises `base` to the power of `exp` modulo `mod.modulus()`, reusing the precomputed context for all of the multiplications.
+ * @throws std::domain_error if base == exp == 0
+ */
+template<is_BigInt_like BASE, is_BigInt_like EXP, one_of<BarrettReducer, MontgomeryContext> CONTEXT>
+BIGINT_TRACY_CONSTEXPR_AUTO
+pow_mod(const BASE& base, const EXP& exp, const CONTEXT& mod) -> BigInt {
+	BIGINT_TRACY_ZONE_SCOPED;
+	if (is_zero(exp)) {
+		if (is_zero(base)) {
+			throw std::domain_error{utils::error_msg("zero to the power of zero is undefined.")};
+		} else {
+			return BigInt{1};
 		}
-		if (i+1 < exp_bits) {
-			temp = (temp * temp) % mod;
+	} else if (is_neg(exp)) {
+		return BigInt{0};
+	} else if (is_zero(base)) {
+		return BigInt{0};
+	} else if (mod.modulus() == 1) {
+		return BigInt{0};
+	}
+	if constexpr (std::is_same_v<CONTEXT, MontgomeryContext>) {
+		return mod.pow(base, exp);
+	} else {
+		const uint64_t exp_bits = (exp.size() - 1) * 64 + (64 - utils::clzll(exp[exp.size()-1]));
+
+		BigInt result{1};
+		auto temp = mod.reduce(base);
+		for (uint64_t i = 0; i < exp_bits; ++i) {
+			const auto mask = 1ull << (i % 64);
+			if (exp[i/64] & mask) {
+				result = mod.reduce(result * temp);
+			}
+			if (i+1 < exp_bits) {
+				temp = mod.reduce(square(temp));
+			}
 		}
+		return result;
 	}
-	return result;
 }
 
 }
@@ -2278,6 +5993,125 @@ lcm(const BigInt& u, const BigInt& v) -> BigInt {
 }
 
 
+// workspace:
+namespace bigint {
+
+/**
+ * @brief scratch memory for the workspace overloads mult(result, a, b, ws), square(result, a, ws), divmod(q, r, a, b, ws), sqrt(result, y, ws),
+ *        pow_mod(result, base, exp, mod, ws), gcd(result, u, v, ws) and mulmod(result, a, b, m, ws).
+ *        The temporaries of those calls come from a pool owned by the workspace, and their results are written into the existing storage
+ *        of the output arguments. So a loop that keeps reusing the same workspace and outputs stops allocating once both have grown
+ *        to the sizes it needs. A workspace must not be used by more than one thread at a time.
+ */
+class Workspace {
+public:
+	/**
+	 * @param upstream where the pool gets its memory from.
+	 */
+	explicit
+	Workspace(std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+		: _pool(std::pmr::pool_options{0, max_pooled_bytes}, upstream)
+	{ }
+
+	Workspace(const Workspace&) = delete;
+	Workspace& operator=(const Workspace&) = delete;
+
+	NODISCARD_AUTO
+	resource() noexcept -> std::pmr::memory_resource* {
+		return &_pool;
+	}
+
+private:
+	/// larger blocks go straight to the upstream resource.
+	static constexpr std::size_t max_pooled_bytes = std::size_t{1} << 24;
+
+	std::pmr::unsynchronized_pool_resource _pool;
+};
+
+}
+
+
+namespace bigint::_private {
+
+/**
+ * @brief to = from, reusing the storage of `to`.
+ */
+BIGINT_TRACY_CONSTEXPR_VOID
+assign_digits(BigInt &to, const BigInt &from) {
+	to.resize(from.size());
+	copy_digits_to_from(to, from);
+	to.sign() = from.sign();
+}
+
+/**
+ * @brief calls calculate() with all temporaries allocated from `ws` and assigns what it returns (a BigInt, or a DivModResult)
+ *        to the outputs, which keep getting their storage from the resource that was current before.
+ */
+template <typename F>
+void
+calculate_in_workspace(Workspace &ws, const F &calculate, BigInt &result, BigInt *remainder = nullptr) {
+	std::pmr::memory_resource *const outer = memory_resource();
+	ScopedMemoryResource scratch{ws.resource()};
+	const auto value = calculate();
+	ScopedMemoryResource output{outer};
+	if constexpr (std::is_same_v<std::remove_cv_t<decltype(value)>, BigInt>) {
+		assign_digits(result, value);
+	} else {
+		assign_digits(result, value.d);
+		assign_digits(*remainder, value.r);
+	}
+}
+
+}
+
+
+// workspace:
+namespace bigint {
+
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+void
+mult(BigInt &result, const TLHS &a, const TRHS &b, Workspace &ws) {
+	_private::calculate_in_workspace(ws, [&]() { return mult(a, b); }, result);
+}
+
+template <is_BigInt_like T>
+void
+square(BigInt &result, const T &a, Workspace &ws) {
+	_private::calculate_in_workspace(ws, [&]() { return square(a); }, result);
+}
+
+template <is_BigInt_like TLHS, is_BigInt_like TRHS>
+void
+divmod(BigInt &q, BigInt &r, const TLHS &a, const TRHS &b, Workspace &ws) {
+	_private::calculate_in_workspace(ws, [&]() { return divmod(a, b); }, q, &r);
+}
+
+template <is_BigInt_like T>
+void
+sqrt(BigInt &result, const T &y, Workspace &ws) {
+	_private::calculate_in_workspace(ws, [&]() { return sqrt(y); }, result);
+}
+
+template<is_BigInt_like BASE, is_BigInt_like EXP, is_BigInt_like MOD>
+void
+pow_mod(BigInt &result, const BASE &base, const EXP &exp, const MOD &mod, Workspace &ws) {
+	_private::calculate_in_workspace(ws, [&]() { return pow_mod(base, exp, mod); }, result);
+}
+
+inline void
+gcd(BigInt &result, const BigInt &u, const BigInt &v, Workspace &ws) {
+	_private::calculate_in_workspace(ws, [&]() { return gcd(u, v); }, result);
+}
+
+template <is_BigInt_like TLHS, is_BigInt_like TRHS, is_BigInt_like TMOD>
+void
+mulmod(BigInt &result, const TLHS &a, const TRHS &b, const TMOD &m, Workspace &ws) {
+	_private::calculate_in_workspace(ws, [&]() { return mulmod(a, b, m); }, result);
+}
+
+}
+
+
 namespace bigint::_private {
 
 consteval uint8_t calculate_base_power_64(uint32_t base) {
@@ -2554,7 +6388,7 @@ from_string(const std::string_view input) -> BigInt {
 	} else { // special case for when base is a divider of 32.
 
 		const auto digit_count = input.size() - i0;
-		const auto big_int_digit_count = std::max(0ull, digit_count / conv.base_power + (digit_count % conv.base_power > 0 ? 1 : 0));
+		const auto big_int_digit_count = std::max((size_t)0, digit_count / conv.base_power + (digit_count % conv.base_power > 0 ? 1 : 0));
 		result.resize(big_int_digit_count);
 
 		size_t i = input.size();
@@ -0,0 +1,549 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include "utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Limb kernels: the innermost loops of the BigInt algorithms, working on raw, contiguous digit arrays.
+ *
+ * Every kernel has a portable constexpr implementation in bigint::kernels::generic. On x86-64 with GCC or Clang,
+ * hand written assembly versions are selected once at runtime via cpuid:
+ *  - add_n, sub_n: adc/sbb chains, unrolled by 4.
+ *  - lshift, rshift: shld/shrd.
+ *  - mul_1, submul_1: mulx (BMI2).
+ *  - addmul_1: mulx with the two independent carry chains of adcx/adox (BMI2 + ADX).
+ * Define BIGINT_DISABLE_ASM to always use the portable versions.
+ * During constant evaluation the portable versions are used as well.
+ */
+#if defined(BIGINT_X86_64) && !defined(_MSC_VER) && !defined(BIGINT_DISABLE_ASM)
+#	define BIGINT_KERNELS_ASM
+#	include <cpuid.h>
+#endif
+
+
+// portable kernels:
+namespace bigint::kernels::generic {
+
+/**
+ * @brief rp[i] = ap[i] + bp[i] for i < n. rp may be equal to ap or bp.
+ * @return the carry out of rp[n - 1]
+ */
+CONSTEXPR_AUTO_DISCARD
+add_n(uint64_t *rp, const uint64_t *ap, const uint64_t *bp, std::size_t n) noexcept -> uint64_t {
+	uint8_t c = 0; // carry
+	for (std::size_t i = 0; i < n; ++i) {
+		rp[i] = utils::add_carry(ap[i], bp[i], c);
+	}
+	return c;
+}
+
+/**
+ * @brief rp[i] = ap[i] - bp[i] for i < n. rp may be equal to ap or bp.
+ * @return the borrow out of rp[n - 1]
+ */
+CONSTEXPR_AUTO_DISCARD
+sub_n(uint64_t *rp, const uint64_t *ap, const uint64_t *bp, std::size_t n) noexcept -> uint64_t {
+	uint8_t c = 0; // borrow
+	for (std::size_t i = 0; i < n; ++i) {
+		rp[i] = utils::sub_borrow(ap[i], bp[i], c);
+	}
+	return c;
+}
+
+/**
+ * @brief rp[i] = ap[i] * b for i < n. rp may be equal to ap.
+ * @return the carry out of rp[n - 1], a full digit
+ */
+CONSTEXPR_AUTO_DISCARD
+mul_1(uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept -> uint64_t {
+	uint64_t c = 0; // carry
+	for (std::size_t i = 0; i < n; ++i) {
+		uint64_t hi;
+		const auto lo = utils::mult_u128(ap[i], b, hi);
+		uint8_t k = 0;
+		rp[i] = utils::add_carry(lo, c, k);
+		c = hi + k;
+	}
+	return c;
+}
+
+/**
+ * @brief rp[i] += ap[i] * b for i < n.
+ * @return the carry out of rp[n - 1], a full digit
+ */
+CONSTEXPR_AUTO_DISCARD
+addmul_1(uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept -> uint64_t {
+	uint64_t c = 0; // carry
+	for (std::size_t i = 0; i < n; ++i) {
+		uint64_t hi;
+		const auto lo = utils::mult_u128(ap[i], b, hi);
+		uint8_t k = 0;
+		const auto lo_c = utils::add_carry(lo, c, k);
+		hi += k;
+		k = 0;
+		rp[i] = utils::add_carry(rp[i], lo_c, k);
+		c = hi + k; // ap[i] * b + rp[i] + c < 2^128, so this never overflows.
+	}
+	return c;
+}
+
+/**
+ * @brief rp[i] -= ap[i] * b for i < n.
+ * @return the borrow out of rp[n - 1], a full digit
+ */
+CONSTEXPR_AUTO_DISCARD
+submul_1(uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept -> uint64_t {
+	uint64_t c = 0; // borrow
+	for (std::size_t i = 0; i < n; ++i) {
+		uint64_t hi;
+		const auto lo = utils::mult_u128(ap[i], b, hi);
+		uint8_t k = 0;
+		const auto lo_c = utils::add_carry(lo, c, k);
+		hi += k;
+		k = 0;
+		rp[i] = utils::sub_borrow(rp[i], lo_c, k);
+		c = hi + k;
+	}
+	return c;
+}
+
+/**
+ * @brief the n digits of ap shifted left by 0 < cnt < 64 bits, stored in rp. Works from the most significant digit down,
+ *        so rp may overlap ap as long as rp >= ap.
+ * @return the bits shifted out of ap[n - 1], in the low bits of the result
+ */
+CONSTEXPR_AUTO_DISCARD
+lshift(uint64_t *rp, const uint64_t *ap, std::size_t n, unsigned cnt) noexcept -> uint64_t {
+	const uint64_t out = ap[n - 1] >> (64 - cnt);
+	for (std::size_t i = n - 1; i > 0; --i) {
+		rp[i] = (ap[i] << cnt) | (ap[i - 1] >> (64 - cnt));
+	}
+	rp[0] = ap[0] << cnt;
+	return out;
+}
+
+/**
+ * @brief the n digits of ap shifted right by 0 < cnt < 64 bits, stored in rp. Works from the least significant digit up,
+ *        so rp may overlap ap as long as rp <= ap.
+ * @return the bits shifted out of ap[0], in the high bits of the result
+ */
+CONSTEXPR_AUTO_DISCARD
+rshift(uint64_t *rp, const uint64_t *ap, std::size_t n, unsigned cnt) noexcept -> uint64_t {
+	const uint64_t out = ap[0] << (64 - cnt);
+	for (std::size_t i = 0; i + 1 < n; ++i) {
+		rp[i] = (ap[i] >> cnt) | (ap[i + 1] << (64 - cnt));
+	}
+	rp[n - 1] = ap[n - 1] >> cnt;
+	return out;
+}
+
+}
+
+
+// x86-64 kernels:
+#ifdef BIGINT_KERNELS_ASM
+namespace bigint::kernels::_private::x86_64 {
+
+// All loops below only use lea, mov, inc/dec and jrcxz between the arithmetic instructions, which leave the carry
+// flag (and, except for inc/dec, the overflow flag) untouched, so the carry chains are never spilled to a register.
+
+inline auto
+add_n(uint64_t *rp, const uint64_t *ap, const uint64_t *bp, std::size_t n) noexcept -> uint64_t {
+	uint64_t rest = n % 4, blocks = n / 4, t0, t1, c;
+	__asm__ volatile(
+		"testq %[rest], %[rest]\n\t" // clears CF
+		"jz 2f\n"
+		"1:\n\t"
+		"movq (%[a]), %[t0]\n\t"
+		"adcq (%[b]), %[t0]\n\t"
+		"movq %[t0], (%[r])\n\t"
+		"leaq 8(%[a]), %[a]\n\t"
+		"leaq 8(%[b]), %[b]\n\t"
+		"leaq 8(%[r]), %[r]\n\t"
+		"decq %[rest]\n\t"
+		"jnz 1b\n"
+		"2:\n\t"
+		"decq %[blocks]\n\t"
+		"js 3f\n\t"
+		"movq (%[a]), %[t0]\n\t"
+		"movq 8(%[a]), %[t1]\n\t"
+		"adcq (%[b]), %[t0]\n\t"
+		"adcq 8(%[b]), %[t1]\n\t"
+		"movq %[t0], (%[r])\n\t"
+		"movq %[t1], 8(%[r])\n\t"
+		"movq 16(%[a]), %[t0]\n\t"
+		"movq 24(%[a]), %[t1]\n\t"
+		"adcq 16(%[b]), %[t0]\n\t"
+		"adcq 24(%[b]), %[t1]\n\t"
+		"movq %[t0], 16(%[r])\n\t"
+		"movq %[t1], 24(%[r])\n\t"
+		"leaq 32(%[a]), %[a]\n\t"
+		"leaq 32(%[b]), %[b]\n\t"
+		"leaq 32(%[r]), %[r]\n\t"
+		"jmp 2b\n"
+		"3:\n\t"
+		"sbbq %[c], %[c]\n\t"
+		: [r]"+r"(rp), [a]"+r"(ap), [b]"+r"(bp), [rest]"+r"(rest), [blocks]"+r"(blocks),
+		  [t0]"=&r"(t0), [t1]"=&r"(t1), [c]"=r"(c)
+		:
+		: "cc", "memory");
+	return c & 1;
+}
+
+inline auto
+sub_n(uint64_t *rp, const uint64_t *ap, const uint64_t *bp, std::size_t n) noexcept -> uint64_t {
+	uint64_t rest = n % 4, blocks = n / 4, t0, t1, c;
+	__asm__ volatile(
+		"testq %[rest], %[rest]\n\t" // clears CF
+		"jz 2f\n"
+		"1:\n\t"
+		"movq (%[a]), %[t0]\n\t"
+		"sbbq (%[b]), %[t0]\n\t"
+		"movq %[t0], (%[r])\n\t"
+		"leaq 8(%[a]), %[a]\n\t"
+		"leaq 8(%[b]), %[b]\n\t"
+		"leaq 8(%[r]), %[r]\n\t"
+		"decq %[rest]\n\t"
+		"jnz 1b\n"
+		"2:\n\t"
+		"decq %[blocks]\n\t"
+		"js 3f\n\t"
+		"movq (%[a]), %[t0]\n\t"
+		"movq 8(%[a]), %[t1]\n\t"
+		"sbbq (%[b]), %[t0]\n\t"
+		"sbbq 8(%[b]), %[t1]\n\t"
+		"movq %[t0], (%[r])\n\t"
+		"movq %[t1], 8(%[r])\n\t"
+		"movq 16(%[a]), %[t0]\n\t"
+		"movq 24(%[a]), %[t1]\n\t"
+		"sbbq 16(%[b]), %[t0]\n\t"
+		"sbbq 24(%[b]), %[t1]\n\t"
+		"movq %[t0], 16(%[r])\n\t"
+		"movq %[t1], 24(%[r])\n\t"
+		"leaq 32(%[a]), %[a]\n\t"
+		"leaq 32(%[b]), %[b]\n\t"
+		"leaq 32(%[r]), %[r]\n\t"
+		"jmp 2b\n"
+		"3:\n\t"
+		"sbbq %[c], %[c]\n\t"
+		: [r]"+r"(rp), [a]"+r"(ap), [b]"+r"(bp), [rest]"+r"(rest), [blocks]"+r"(blocks),
+		  [t0]"=&r"(t0), [t1]"=&r"(t1), [c]"=r"(c)
+		:
+		: "cc", "memory");
+	return c & 1;
+}
+
+inline auto
+lshift(uint64_t *rp, const uint64_t *ap, std::size_t n, unsigned cnt) noexcept -> uint64_t {
+	const uint64_t out = ap[n - 1] >> (64 - cnt);
+	uint64_t i = n - 1, lo, hi;
+	__asm__ volatile(
+		"testq %[i], %[i]\n\t"
+		"jz 2f\n"
+		"1:\n\t"
+		"movq -8(%[a],%[i],8), %[lo]\n\t"
+		"movq (%[a],%[i],8), %[hi]\n\t"
+		"shldq %%cl, %[lo], %[hi]\n\t"
+		"movq %[hi], (%[r],%[i],8)\n\t"
+		"decq %[i]\n\t"
+		"jnz 1b\n"
+		"2:\n\t"
+		: [i]"+r"(i), [lo]"=&r"(lo), [hi]"=&r"(hi)
+		: [r]"r"(rp), [a]"r"(ap), "c"(cnt)
+		: "cc", "memory");
+	rp[0] = ap[0] << cnt;
+	return out;
+}
+
+inline auto
+rshift(uint64_t *rp, const uint64_t *ap, std::size_t n, unsigned cnt) noexcept -> uint64_t {
+	const uint64_t out = ap[0] << (64 - cnt);
+	// i runs from -(n - 1) to 0, with rp and ap pointing to their last digit.
+	int64_t i = 1 - int64_t(n);
+	uint64_t lo, hi;
+	__asm__ volatile(
+		"testq %[i], %[i]\n\t"
+		"jz 2f\n"
+		"1:\n\t"
+		"movq (%[a],%[i],8), %[lo]\n\t"
+		"movq 8(%[a],%[i],8), %[hi]\n\t"
+		"shrdq %%cl, %[hi], %[lo]\n\t"
+		"movq %[lo], (%[r],%[i],8)\n\t"
+		"incq %[i]\n\t"
+		"jnz 1b\n"
+		"2:\n\t"
+		: [i]"+r"(i), [lo]"=&r"(lo), [hi]"=&r"(hi)
+		: [r]"r"(rp + n - 1), [a]"r"(ap + n - 1), "c"(cnt)
+		: "cc", "memory");
+	rp[n - 1] = ap[n - 1] >> cnt;
+	return out;
+}
+
+inline auto
+mul_1_bmi2(uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept -> uint64_t {
+	uint64_t c = 0, lo, hi;
+	__asm__ volatile(
+		"1:\n\t"
+		"mulxq (%[a]), %[lo], %[hi]\n\t"
+		"addq %[c], %[lo]\n\t"
+		"adcq $0, %[hi]\n\t"
+		"movq %[lo], (%[r])\n\t"
+		"movq %[hi], %[c]\n\t"
+		"leaq 8(%[a]), %[a]\n\t"
+		"leaq 8(%[r]), %[r]\n\t"
+		"decq %[n]\n\t"
+		"jnz 1b\n\t"
+		: [r]"+r"(rp), [a]"+r"(ap), [n]"+r"(n), [c]"+r"(c), [lo]"=&r"(lo), [hi]"=&r"(hi)
+		: "d"(b)
+		: "cc", "memory");
+	return c;
+}
+
+inline auto
+submul_1_bmi2(uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept -> uint64_t {
+	uint64_t c = 0, lo, hi, t;
+	__asm__ volatile(
+		"1:\n\t"
+		"mulxq (%[a]), %[lo], %[hi]\n\t"
+		"addq %[c], %[lo]\n\t"
+		"adcq $0, %[hi]\n\t"
+		"movq (%[r]), %[t]\n\t"
+		"subq %[lo], %[t]\n\t"
+		"adcq $0, %[hi]\n\t"
+		"movq %[t], (%[r])\n\t"
+		"movq %[hi], %[c]\n\t"
+		"leaq 8(%[a]), %[a]\n\t"
+		"leaq 8(%[r]), %[r]\n\t"
+		"decq %[n]\n\t"
+		"jnz 1b\n\t"
+		: [r]"+r"(rp), [a]"+r"(ap), [n]"+r"(n), [c]"+r"(c), [lo]"=&r"(lo), [hi]"=&r"(hi), [t]"=&r"(t)
+		: "d"(b)
+		: "cc", "memory");
+	return c;
+}
+
+inline auto
+addmul_1_bmi2_adx(uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept -> uint64_t {
+	// CF carries ap[i] * b + c, OF carries the addition of rp[i]. Both carries end up in the high digit of the next
+	// product, so they never have to be merged inside the loop. The loop counter lives in rcx, so that jrcxz can test it
+	// without touching the flags.
+	uint64_t rest = n % 2, blocks = n / 2, c = 0, lo0, hi0, lo1, hi1;
+	__asm__ volatile(
+		"xorl %k[lo0], %k[lo0]\n\t" // clears CF and OF
+		"testq %[rest], %[rest]\n\t"
+		"jz 2f\n\t"
+		"mulxq (%[a]), %[lo0], %[c]\n\t"
+		"adoxq (%[r]), %[lo0]\n\t"
+		"movq %[lo0], (%[r])\n\t"
+		"leaq 8(%[a]), %[a]\n\t"
+		"leaq 8(%[r]), %[r]\n"
+		"2:\n\t"
+		"jrcxz 3f\n\t"
+		"mulxq (%[a]), %[lo0], %[hi0]\n\t"
+		"mulxq 8(%[a]), %[lo1], %[hi1]\n\t"
+		"adcxq %[c], %[lo0]\n\t"
+		"adoxq (%[r]), %[lo0]\n\t"
+		"adcxq %[hi0], %[lo1]\n\t"
+		"adoxq 8(%[r]), %[lo1]\n\t"
+		"movq %[lo0], (%[r])\n\t"
+		"movq %[lo1], 8(%[r])\n\t"
+		"movq %[hi1], %[c]\n\t"
+		"leaq 16(%[a]), %[a]\n\t"
+		"leaq 16(%[r]), %[r]\n\t"
+		"leaq -1(%%rcx), %%rcx\n\t"
+		"jmp 2b\n"
+		"3:\n\t"
+		"movl $0, %k[lo0]\n\t"
+		"adcxq %[lo0], %[c]\n\t"
+		"adoxq %[lo0], %[c]\n\t"
+		: [r]"+r"(rp), [a]"+r"(ap), [c]"+r"(c), [rest]"+r"(rest), "+c"(blocks),
+		  [lo0]"=&r"(lo0), [hi0]"=&r"(hi0), [lo1]"=&r"(lo1), [hi1]"=&r"(hi1)
+		: "d"(b)
+		: "cc", "memory");
+	return c;
+}
+
+}
+#endif
+
+
+// runtime dispatch:
+namespace bigint::kernels::_private {
+
+struct KernelTable {
+	std::string_view name;
+	uint64_t (*add_n)(uint64_t*, const uint64_t*, const uint64_t*, std::size_t) noexcept;
+	uint64_t (*sub_n)(uint64_t*, const uint64_t*, const uint64_t*, std::size_t) noexcept;
+	uint64_t (*mul_1)(uint64_t*, const uint64_t*, std::size_t, uint64_t) noexcept;
+	uint64_t (*addmul_1)(uint64_t*, const uint64_t*, std::size_t, uint64_t) noexcept;
+	uint64_t (*submul_1)(uint64_t*, const uint64_t*, std::size_t, uint64_t) noexcept;
+	uint64_t (*lshift)(uint64_t*, const uint64_t*, std::size_t, unsigned) noexcept;
+	uint64_t (*rshift)(uint64_t*, const uint64_t*, std::size_t, unsigned) noexcept;
+};
+
+NODISCARD_AUTO
+select_kernels() noexcept -> KernelTable {
+	KernelTable table{
+		"generic",
+		[](uint64_t *rp, const uint64_t *ap, const uint64_t *bp, std::size_t n) noexcept { return generic::add_n(rp, ap, bp, n); },
+		[](uint64_t *rp, const uint64_t *ap, const uint64_t *bp, std::size_t n) noexcept { return generic::sub_n(rp, ap, bp, n); },
+		[](uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept { return generic::mul_1(rp, ap, n, b); },
+		[](uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept { return generic::addmul_1(rp, ap, n, b); },
+		[](uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept { return generic::submul_1(rp, ap, n, b); },
+		[](uint64_t *rp, const uint64_t *ap, std::size_t n, unsigned cnt) noexcept { return generic::lshift(rp, ap, n, cnt); },
+		[](uint64_t *rp, const uint64_t *ap, std::size_t n, unsigned cnt) noexcept { return generic::rshift(rp, ap, n, cnt); },
+	};
+#ifdef BIGINT_KERNELS_ASM
+	table.name = "x86_64";
+	table.add_n = x86_64::add_n;
+	table.sub_n = x86_64::sub_n;
+	table.lshift = x86_64::lshift;
+	table.rshift = x86_64::rshift;
+
+	unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+	if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+		const bool bmi2 = ebx & (1u << 8);
+		const bool adx = ebx & (1u << 19);
+		if (bmi2) {
+			table.name = "x86_64-bmi2";
+			table.mul_1 = x86_64::mul_1_bmi2;
+			table.submul_1 = x86_64::submul_1_bmi2;
+		}
+		if (bmi2 && adx) {
+			table.name = "x86_64-bmi2-adx";
+			table.addmul_1 = x86_64::addmul_1_bmi2_adx;
+		}
+	}
+#endif
+	return table;
+}
+
+NODISCARD_AUTO
+kernel_table() noexcept -> const KernelTable& {
+	static const KernelTable table = select_kernels();
+	return table;
+}
+
+}
+
+
+// kernels:
+namespace bigint::kernels {
+
+/**
+ * @brief the name of the kernel implementation selected for this CPU, e.g. "generic" or "x86_64-bmi2-adx".
+ */
+NODISCARD_AUTO
+implementation() noexcept -> std::string_view {
+	return _private::kernel_table().name;
+}
+
+/**
+ * @brief rp[i] = ap[i] + bp[i] for i < n. rp may be equal to ap or bp.
+ * @return the carry out of rp[n - 1]
+ */
+CONSTEXPR_AUTO_DISCARD
+add_n(uint64_t *rp, const uint64_t *ap, const uint64_t *bp, std::size_t n) noexcept -> uint64_t {
+	if (std::is_constant_evaluated() || n == 0) {
+		return generic::add_n(rp, ap, bp, n);
+	}
+	return _private::kernel_table().add_n(rp, ap, bp, n);
+}
+
+/**
+ * @brief rp[i] = ap[i] - bp[i] for i < n. rp may be equal to ap or bp.
+ * @return the borrow out of rp[n - 1]
+ */
+CONSTEXPR_AUTO_DISCARD
+sub_n(uint64_t *rp, const uint64_t *ap, const uint64_t *bp, std::size_t n) noexcept -> uint64_t {
+	if (std::is_constant_evaluated() || n == 0) {
+		return generic::sub_n(rp, ap, bp, n);
+	}
+	return _private::kernel_table().sub_n(rp, ap, bp, n);
+}
+
+/**
+ * @brief rp[i] = ap[i] * b for i < n. rp may be equal to ap.
+ * @return the carry out of rp[n - 1], a full digit
+ */
+CONSTEXPR_AUTO_DISCARD
+mul_1(uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept -> uint64_t {
+	if (std::is_constant_evaluated() || n == 0) {
+		return generic::mul_1(rp, ap, n, b);
+	}
+	return _private::kernel_table().mul_1(rp, ap, n, b);
+}
+
+/**
+ * @brief rp[i] += ap[i] * b for i < n.
+ * @return the carry out of rp[n - 1], a full digit
+ */
+CONSTEXPR_AUTO_DISCARD
+addmul_1(uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept -> uint64_t {
+	if (std::is_constant_evaluated() || n == 0) {
+		return generic::addmul_1(rp, ap, n, b);
+	}
+	return _private::kernel_table().addmul_1(rp, ap, n, b);
+}
+
+/**
+ * @brief rp[i] -= ap[i] * b for i < n.
+ * @return the borrow out of rp[n - 1], a full digit
+ */
+CONSTEXPR_AUTO_DISCARD
+submul_1(uint64_t *rp, const uint64_t *ap, std::size_t n, uint64_t b) noexcept -> uint64_t {
+	if (std::is_constant_evaluated() || n == 0) {
+		return generic::submul_1(rp, ap, n, b);
+	}
+	return _private::kernel_table().submul_1(rp, ap, n, b);
+}
+
+/**
+ * @brief the n digits of ap shifted left by cnt < 64 bits, stored in rp. rp may overlap ap as long as rp >= ap.
+ * @return the bits shifted out of ap[n - 1], in the low bits of the result
+ */
+CONSTEXPR_AUTO_DISCARD
+lshift(uint64_t *rp, const uint64_t *ap, std::size_t n, unsigned cnt) noexcept -> uint64_t {
+	if (n == 0) {
+		return 0;
+	}
+	if (cnt == 0) {
+		for (std::size_t i = n; i --> 0;) {
+			rp[i] = ap[i];
+		}
+		return 0;
+	}
+	if (std::is_constant_evaluated()) {
+		return generic::lshift(rp, ap, n, cnt);
+	}
+	return _private::kernel_table().lshift(rp, ap, n, cnt);
+}
+
+/**
+ * @brief the n digits of ap shifted right by cnt < 64 bits, stored in rp. rp may overlap ap as long as rp <= ap.
+ * @return the bits shifted out of ap[0], in the high bits of the result
+ */
+CONSTEXPR_AUTO_DISCARD
+rshift(uint64_t *rp, const uint64_t *ap, std::size_t n, unsigned cnt) noexcept -> uint64_t {
+	if (n == 0) {
+		return 0;
+	}
+	if (cnt == 0) {
+		for (std::size_t i = 0; i < n; ++i) {
+			rp[i] = ap[i];
+		}
+		return 0;
+	}
+	if (std::is_constant_evaluated()) {
+		return generic::rshift(rp, ap, n, cnt);
+	}
+	return _private::kernel_table().rshift(rp, ap, n, cnt);
+}
+
+}
+
+#endif // KERNELS_H
@@ -1,6 +1,7 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <algorithm>
 #include <charconv>
 #include <stdexcept>
 #include <string>
@@ -247,13 +248,113 @@ using uint128_t_ = unsigned __int128;
 }
 #endif
 
+#if defined(__x86_64__) || defined(_M_X64)
+#	define BIGINT_X86_64
+#	ifndef _MSC_VER
+#		include <x86intrin.h>
+#	endif
+#endif
+
 namespace bigint::utils {
 
-uint64_t __inline div_u128_saturate(uint64_t high_dividend, uint64_t low_dividend, uint64_t divisor) {
+/**
+ * @brief the 128-bit product of a and b.
+ * @param high receives the most significant 64 bits of the product
+ * @return the least significant 64 bits of the product
+ */
+CONSTEXPR_AUTO
+mult_u128(uint64_t a, uint64_t b, uint64_t &high) noexcept -> uint64_t {
+	if (!std::is_constant_evaluated()) {
+#if defined(_MSC_VER) && defined(_M_X64)
+		return _umul128(a, b, &high);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+		high = __umulh(a, b);
+		return a * b;
+#elif !defined(_MSC_VER)
+		const auto product = _private::uint128_t_(a) * b;
+		high = uint64_t(product >> 64);
+		return uint64_t(product);
+#endif
+	}
+	// portable version, also used during constant evaluation.
+	const auto a_0 = a & 0xFFFFFFFFull;
+	const auto a_1 = a >> 32;
+	const auto b_0 = b & 0xFFFFFFFFull;
+	const auto b_1 = b >> 32;
+	const uint64_t r_00 = a_0 * b_0;
+	const uint64_t r_01 = a_0 * b_1;
+	const uint64_t r_10 = a_1 * b_0;
+	const uint64_t r_11 = a_1 * b_1;
+
+	auto c = r_11 >> 0;
+	c += r_01 >> 32;
+	c += r_10 >> 32;
+
+	auto r = r_00 << 0;
+	r += r_01 << 32;
+	c += (r < (r_01 << 32)) ? 1 : 0;
+	r += r_10 << 32;
+	c += (r < (r_10 << 32)) ? 1 : 0;
+	high = c;
+	return r;
+}
+
+/**
+ * @brief a + b + carry
+ * @param carry the incoming carry (0 or 1), receives the outgoing carry
+ */
+CONSTEXPR_AUTO
+add_carry(uint64_t a, uint64_t b, uint8_t &carry) noexcept -> uint64_t {
+#ifdef BIGINT_X86_64
+	if (!std::is_constant_evaluated()) {
+		unsigned long long result;
+		carry = _addcarry_u64(carry, a, b, &result);
+		return result;
+	}
+#endif
+	const uint64_t result = a + b + carry;
+	carry = (result < a || (carry && result == a)) ? 1 : 0;
+	return result;
+}
+
+/**
+ * @brief a - b - borrow
+ * @param borrow the incoming borrow (0 or 1), receives the outgoing borrow
+ */
+CONSTEXPR_AUTO
+sub_borrow(uint64_t a, uint64_t b, uint8_t &borrow) noexcept -> uint64_t {
+#ifdef BIGINT_X86_64
+	if (!std::is_constant_evaluated()) {
+		unsigned long long result;
+		borrow = _subborrow_u64(borrow, a, b, &result);
+		return result;
+	}
+#endif
+	const uint64_t result = a - b - borrow;
+	borrow = (result > a || (borrow && result == a)) ? 1 : 0;
+	return result;
+}
+
+/**
+ * @brief (high_dividend * 2^64 + low_dividend) / divisor, clamped to 2^64 - 1 if the quotient does not fit into 64 bits.
+ */
+CONSTEXPR_AUTO
+div_u128_saturate(uint64_t high_dividend, uint64_t low_dividend, uint64_t divisor) -> uint64_t {
 	if (high_dividend == 0) {
 		return low_dividend / divisor;
 	}
 	if (high_dividend < divisor) {
+		if (!std::is_constant_evaluated()) {
+			// the quotient fits into 64 bits, so a single hardware division is enough.
+#if defined(BIGINT_X86_64) && !defined(_MSC_VER)
+			uint64_t quotient, remainder;
+			__asm__("divq %4" : "=a"(quotient), "=d"(remainder) : "a"(low_dividend), "d"(high_dividend), "rm"(divisor));
+			return quotient;
+#elif defined(BIGINT_X86_64) && _MSC_VER >= 1920
+			uint64_t remainder;
+			return _udiv128(high_dividend, low_dividend, divisor, &remainder);
+#endif
+		}
 		const auto a2 = (_private::uint128_t_(high_dividend) << 64) | _private::uint128_t_(low_dividend);
 		const auto q = a2 / divisor;
 		return (uint64_t)q;
@@ -263,6 +364,18 @@ uint64_t __inline div_u128_saturate(uint64_t high_dividend, uint64_t low_dividen
 	}
 }
 
+/**
+ * @brief x^-1 mod 2^64 for odd x by Newton's iteration, which doubles the number of correct bits with every step.
+ */
+CONSTEXPR_AUTO
+inverse_mod_2_64(uint64_t x) noexcept -> uint64_t {
+	uint64_t inv = x; // correct to 3 bits, because x*x == 1 mod 8 for all odd x.
+	for (int i = 0; i < 5; ++i) {
+		inv *= 2 - x * inv;
+	}
+	return inv;
+}
+
 }
 
 #endif // UTILS_H
@@ -9,6 +9,10 @@
 
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+#include <random>
+#include <tuple>
+
 namespace {
 using namespace bigint;
 using namespace test_data;
@@ -51,6 +55,23 @@ inline void test_assignment_operation(
 	testOperationBase<N, R&, On...>(operation, tests, test_func);
 }
 
+
+/**
+ * replaces bigint::tuning for the lifetime of this object. Used to force the algorithms for large operands on smaller test values.
+ */
+struct ScopedTuning {
+	explicit ScopedTuning(const bigint::Tuning& new_tuning)
+		: old_tuning(bigint::tuning) {
+		bigint::tuning = new_tuning;
+	}
+
+	~ScopedTuning() {
+		bigint::tuning = old_tuning;
+	}
+
+	const bigint::Tuning old_tuning;
+};
+
 }
 
 /* ***************************************************************************************
@@ -255,6 +276,17 @@ TEST(HelloTest, Test##NAME##_##O1) {\
 #define TEST_UNARY_OPERATOR_BIGINT(NAME, O1, OP, TEST_VALUES) \
 TEST_UNARY_OPERATOR(NAME, O1, BigInt, OP, TEST_VALUES, std::vector<uint64_t>, res.__data_for_testing_only())
 
+// the last argument is the bigint::Tuning used during the test.
+#define TEST_UNARY_OPERATOR_BIGINT_TUNED(NAME, O1, OP, TEST_VALUES, ...) \
+TEST(HelloTest, Test##NAME##_##O1) {\
+	const ScopedTuning scoped_tuning{__VA_ARGS__};\
+	test_operation<1, BigInt, std::vector<uint64_t>, O1>(\
+		[](const O1& a) -> BigInt { return OP; },\
+		[](const BigInt& res) -> std::vector<uint64_t> { return res.__data_for_testing_only(); },\
+		TEST_VALUES\
+	);\
+}
+
 
 
 #define TEST_BINARY_OPERATOR(NAME, O1, O2, R, OP, TEST_VALUES, RT, GET_RT) \
@@ -269,6 +301,17 @@ TEST(HelloTest, Test##NAME##_##O1##_##O2) {\
 #define TEST_BINARY_OPERATOR_BIGINT(NAME, O1, O2, OP, TEST_VALUES) \
 TEST_BINARY_OPERATOR(NAME, O1, O2, BigInt, OP, TEST_VALUES, std::vector<uint64_t>, res.__data_for_testing_only())
 
+// the last argument is the bigint::Tuning used during the test.
+#define TEST_BINARY_OPERATOR_BIGINT_TUNED(NAME, O1, O2, OP, TEST_VALUES, ...) \
+TEST(HelloTest, Test##NAME##_##O1##_##O2) {\
+	const ScopedTuning scoped_tuning{__VA_ARGS__};\
+	test_operation<2, BigInt, std::vector<uint64_t>, O1, O2>(\
+		[](const O1& a, const O2& b) -> BigInt { return OP; },\
+		[](const BigInt& res) -> std::vector<uint64_t> { return res.__data_for_testing_only(); },\
+		TEST_VALUES\
+	);\
+}
+
 
 #define TEST_ASSIGN_OPERATOR(NAME, O1, O2, OP, TEST_VALUES, RT, GET_RT) \
 TEST(HelloTest, TestI##NAME##_##O1##_##O2) {\
@@ -403,6 +446,44 @@ TEST_BINARY_OPERATOR_BIGINT(Mul, int32_t, BigInt, a * b, get_all_mul_test_values
 
 TEST_BINARY_OPERATOR_BIGINT(Mul, uint64_t, uint64_t, BigInt{mult(a, b)}, get_all_mul_test_values())
 
+TEST_BINARY_OPERATOR_BIGINT(MulLarge, BigInt, BigInt, a * b, get_all_mul_large_test_values())
+
+TEST_BINARY_OPERATOR_BIGINT_TUNED(MulSchoolbook, BigInt, BigInt, a * b, get_all_mul_large_test_values(), Tuning{.karatsuba_threshold = 1'000'000})
+
+TEST_BINARY_OPERATOR_BIGINT_TUNED(MulKaratsuba, BigInt, BigInt, a * b, get_all_mul_test_values(), Tuning{.karatsuba_threshold = 2})
+
+TEST_BINARY_OPERATOR_BIGINT_TUNED(MulToom3, BigInt, BigInt, a * b, get_all_mul_large_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 3, .toom4_threshold = 1'000'000})
+
+TEST_BINARY_OPERATOR_BIGINT_TUNED(MulToom4, BigInt, BigInt, a * b, get_all_mul_large_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 3, .toom4_threshold = 4})
+
+TEST_BINARY_OPERATOR_BIGINT_TUNED(MulUnbalanced, BigInt, BigInt, a * b, get_all_mul_large_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 1'000'000})
+
+TEST_BINARY_OPERATOR_BIGINT_TUNED(MulNtt, BigInt, BigInt, a * b, get_all_mul_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 2, .toom4_threshold = 2, .ntt_threshold = 2})
+
+TEST_BINARY_OPERATOR_BIGINT_TUNED(MulNttLarge, BigInt, BigInt, a * b, get_all_mul_large_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 2, .toom4_threshold = 2, .ntt_threshold = 2})
+
+TEST_UNARY_OPERATOR_BIGINT(Square, BigInt, square(a), get_all_square_test_values())
+
+TEST_UNARY_OPERATOR_BIGINT(SquareSelf, BigInt, a * a, get_all_square_test_values())
+
+TEST_UNARY_OPERATOR_BIGINT(SquareLarge, BigInt, square(a), get_all_square_large_test_values())
+
+TEST_UNARY_OPERATOR_BIGINT_TUNED(SquareSchoolbook, BigInt, square(a), get_all_square_large_test_values(), Tuning{.karatsuba_threshold = 1'000'000})
+
+TEST_UNARY_OPERATOR_BIGINT_TUNED(SquareKaratsuba, BigInt, square(a), get_all_square_large_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 1'000'000})
+
+TEST_UNARY_OPERATOR_BIGINT_TUNED(SquareToom3, BigInt, square(a), get_all_square_large_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 3, .toom4_threshold = 1'000'000})
+
+TEST_UNARY_OPERATOR_BIGINT_TUNED(SquareToom4, BigInt, square(a), get_all_square_large_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 3, .toom4_threshold = 4, .ntt_threshold = 1'000'000})
+
+TEST_UNARY_OPERATOR_BIGINT_TUNED(SquareNtt, BigInt, square(a), get_all_square_large_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 2, .toom4_threshold = 2, .ntt_threshold = 2})
+
+TEST_BINARY_OPERATOR_BIGINT_TUNED(MulParallel, BigInt, BigInt, a * b, get_all_mul_large_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 3, .toom4_threshold = 4, .ntt_threshold = 200, .threads = 4, .parallel_threshold = 2})
+
+TEST_UNARY_OPERATOR_BIGINT_TUNED(SquareParallel, BigInt, square(a), get_all_square_large_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 3, .toom4_threshold = 4, .ntt_threshold = 200, .threads = 4, .parallel_threshold = 2})
+
+TEST_BINARY_OPERATOR_BIGINT_TUNED(MulNoThreads, BigInt, BigInt, a * b, get_all_mul_large_test_values(), Tuning{.karatsuba_threshold = 2, .toom3_threshold = 3, .toom4_threshold = 4, .ntt_threshold = 200, .threads = 0, .parallel_threshold = 2})
+
 TEST_ASSIGN_OPERATOR_BIGINT(Mul, BigInt, a *= b, get_all_mul_test_values())
 
 TEST_ASSIGN_OPERATOR_BIGINT(Mul, uint64_t, a *= b, get_all_mul_test_values())
@@ -464,6 +545,10 @@ TEST_DIV_ASSIGN_OPERATOR_BIGINT(Div, uint32_t, a /= b, get_all_div_test_values()
 
 TEST_DIV_ASSIGN_OPERATOR_BIGINT(Div, int32_t, a /= b, get_all_div_test_values())
 
+TEST_BINARY_OPERATOR_BIGINT_TUNED(DivBurnikelZiegler, BigInt, BigInt, a / b, get_all_div_test_values(), Tuning{.burnikel_ziegler_threshold = 2})
+
+TEST_BINARY_OPERATOR_BIGINT_TUNED(DivNewton, BigInt, BigInt, a / b, get_all_div_test_values(), Tuning{.newton_threshold = 1})
+
 }
 
 
@@ -482,6 +567,10 @@ TEST_DIV_OPERATOR(Mod, BigInt, int32_t, int32_t, a % b, get_all_mod_test_values(
 
 TEST_DIV_ASSIGN_OPERATOR_BIGINT(Mod, BigInt, a %= b, get_all_mod_test_values())
 
+TEST_BINARY_OPERATOR_BIGINT_TUNED(ModBurnikelZiegler, BigInt, BigInt, a % b, get_all_mod_test_values(), Tuning{.burnikel_ziegler_threshold = 2})
+
+TEST_BINARY_OPERATOR_BIGINT_TUNED(ModNewton, BigInt, BigInt, a % b, get_all_mod_test_values(), Tuning{.newton_threshold = 1})
+
 }
 
 
@@ -736,3 +825,973 @@ TEST(HelloTest, TestUserDefinedLiteralBin) {
 }
 
 }
+
+
+// constant evaluation
+namespace {
+
+constexpr auto
+mixed_arithmetic(uint64_t x) -> std::array<uint64_t, 4> {
+	const BigInt a = BigInt{x} * BigInt{x} * BigInt{x};
+	const BigInt q = square(a) / BigInt{123456789ull};
+	uint64_t high = 0;
+	const uint64_t low = utils::mult_u128(x, x - 1, high);
+	return {q[0], q[2], low, high};
+}
+
+TEST(HelloTest, TestConstantEvaluationMatchesRuntime) {
+	// constant evaluation uses the portable code paths, runtime may use 128-bit arithmetic and intrinsics.
+	constexpr auto compile_time = mixed_arithmetic(0xFFFFFFFFFFFFFFFFull);
+	volatile uint64_t x = 0xFFFFFFFFFFFFFFFFull;
+	EXPECT_EQ(mixed_arithmetic(x), compile_time);
+	EXPECT_EQ(utils::div_u128_saturate(3, 5, 7), uint64_t(((utils::_private::uint128_t_(3) << 64) | 5) / 7));
+}
+
+}
+
+
+// limb kernels
+namespace {
+
+static_assert(bigint::_private::has_contiguous_digits<BigInt>);
+static_assert(bigint::_private::has_mutable_contiguous_digits<BigInt>);
+static_assert(!bigint::_private::has_mutable_contiguous_digits<const BigInt>);
+static_assert(bigint::_private::has_contiguous_digits<bigint::_private::BigIntSlice<BigInt>>);
+static_assert(bigint::_private::has_contiguous_digits<BigIntAdapter2>);
+static_assert(bigint::_private::has_contiguous_digits<BigIntAdapter<int32_t>>);
+static_assert(!bigint::_private::has_contiguous_digits<bigint::_private::BigIntLShifted<const BigInt&>>);
+
+TEST(HelloTest, TestDigitsSpan) {
+	BigInt a = 0x1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF_big;
+	ASSERT_EQ(a.digits().size(), a.size());
+	for (std::size_t i = 0; i < a.size(); ++i) {
+		EXPECT_EQ(a.digits()[i], a[i]);
+	}
+	a.digits()[0] = 42;
+	EXPECT_EQ(a[0], 42);
+
+	const auto slice = bigint::_private::sliced(a, 1, 5);
+	EXPECT_EQ(slice.digits().size(), slice.size());
+	EXPECT_EQ(slice.digits()[0], a[1]);
+	const auto past_the_end = bigint::_private::sliced(a, 7, 2);
+	ASSERT_EQ(past_the_end.digits().size(), 1);
+	EXPECT_EQ(past_the_end.digits()[0], 0);
+
+	const auto rs = bigint::_private::rshifted(a, 2);
+	EXPECT_EQ(rs.digits().size(), 1);
+	EXPECT_EQ(rs.digits()[0], a[2]);
+
+	EXPECT_EQ(BigIntAdapter<int32_t>(-7).digits()[0], 7);
+	const auto two_digits = BigIntAdapter2{1, 2};
+	EXPECT_EQ(two_digits.digits().size(), 2);
+	EXPECT_EQ(BigIntAdapter2(3, 0).digits().size(), 1);
+}
+
+TEST(HelloTest, TestKernelsMatchGeneric) {
+	// the selected (possibly hand written assembly) kernels must agree with the portable ones, including all tails of the unrolled loops.
+	SCOPED_TRACE(std::string(kernels::implementation()));
+	std::mt19937_64 rng{42};
+	for (std::size_t n = 1; n < 40; ++n) {
+		std::vector<uint64_t> a(n), b(n), r(n), expected(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			// many all-ones digits make long carry chains likely.
+			a[i] = (rng() % 3 == 0) ? ~0ull : rng();
+			b[i] = (rng() % 3 == 0) ? ~0ull : rng();
+		}
+		const uint64_t m = (n % 2 == 0) ? ~0ull : rng();
+
+		EXPECT_EQ(kernels::add_n(r.data(), a.data(), b.data(), n), kernels::generic::add_n(expected.data(), a.data(), b.data(), n)) << n;
+		EXPECT_EQ(r, expected) << "add_n " << n;
+		EXPECT_EQ(kernels::sub_n(r.data(), a.data(), b.data(), n), kernels::generic::sub_n(expected.data(), a.data(), b.data(), n)) << n;
+		EXPECT_EQ(r, expected) << "sub_n " << n;
+		EXPECT_EQ(kernels::mul_1(r.data(), a.data(), n, m), kernels::generic::mul_1(expected.data(), a.data(), n, m)) << n;
+		EXPECT_EQ(r, expected) << "mul_1 " << n;
+
+		r = b;
+		expected = b;
+		EXPECT_EQ(kernels::addmul_1(r.data(), a.data(), n, m), kernels::generic::addmul_1(expected.data(), a.data(), n, m)) << n;
+		EXPECT_EQ(r, expected) << "addmul_1 " << n;
+		EXPECT_EQ(kernels::submul_1(r.data(), a.data(), n, m), kernels::generic::submul_1(expected.data(), a.data(), n, m)) << n;
+		EXPECT_EQ(r, expected) << "submul_1 " << n;
+
+		for (unsigned cnt = 1; cnt < 64; ++cnt) {
+			EXPECT_EQ(kernels::lshift(r.data(), a.data(), n, cnt), kernels::generic::lshift(expected.data(), a.data(), n, cnt)) << n;
+			EXPECT_EQ(r, expected) << "lshift " << n << " " << cnt;
+			EXPECT_EQ(kernels::rshift(r.data(), a.data(), n, cnt), kernels::generic::rshift(expected.data(), a.data(), n, cnt)) << n;
+			EXPECT_EQ(r, expected) << "rshift " << n << " " << cnt;
+		}
+
+		// in place
+		r = a;
+		expected = a;
+		EXPECT_EQ(kernels::add_n(r.data(), r.data(), b.data(), n), kernels::generic::add_n(expected.data(), expected.data(), b.data(), n)) << n;
+		EXPECT_EQ(r, expected) << "add_n in place " << n;
+		EXPECT_EQ(kernels::lshift(r.data(), r.data(), n, 13), kernels::generic::lshift(expected.data(), expected.data(), n, 13)) << n;
+		EXPECT_EQ(r, expected) << "lshift in place " << n;
+		EXPECT_EQ(kernels::rshift(r.data(), r.data(), n, 51), kernels::generic::rshift(expected.data(), expected.data(), n, 51)) << n;
+		EXPECT_EQ(r, expected) << "rshift in place " << n;
+	}
+}
+
+}
+
+
+// digit storage
+namespace {
+
+using SmallDigits = bigint::_private::SmallDigitVector<2>;
+
+constexpr auto
+small_digit_vector_roundtrip() -> std::array<uint64_t, 8> {
+	SmallDigits a{1, 2};           // inline
+	a.insert_front(0);             // spills to the heap
+	a.push_back(3);
+	SmallDigits b = a;             // heap copy
+	SmallDigits c = std::move(a);  // heap move
+	c.resize(1);
+	c.shrink_to_fit();             // back inline
+	c.resize(3);                   // new digits are zero
+	SmallDigits d{7};
+	SmallDigits e = std::move(d);  // inline move
+	e.insert_front(6);
+	return {b[0], b[1], b[2], b[3], c[1] + c[2], e[0], e[1], b.size() + c.size() + e.size()};
+}
+
+static_assert(BIGINT_INLINE_DIGITS != 1 || sizeof(BigInt) == 16);
+
+static_assert(small_digit_vector_roundtrip() == std::array<uint64_t, 8>{0, 1, 2, 3, 0, 6, 7, 9});
+
+TEST(HelloTest, TestSmallDigitVector) {
+	EXPECT_EQ(small_digit_vector_roundtrip(), (std::array<uint64_t, 8>{0, 1, 2, 3, 0, 6, 7, 9}));
+
+	SmallDigits a;
+	for (uint64_t i = 0; i < 100; ++i) {
+		a.push_back(i);
+	}
+	SmallDigits b{5};
+	b = a; // grows
+	SmallDigits c{1, 2};
+	const auto capacity = a.capacity();
+	a = c; // reuses the heap allocation
+	EXPECT_EQ(a.capacity(), capacity);
+	ASSERT_EQ(a.size(), 2);
+	EXPECT_EQ(a[1], 2);
+	ASSERT_EQ(b.size(), 100);
+	for (uint64_t i = 0; i < 100; ++i) {
+		EXPECT_EQ(b[i], i);
+	}
+	EXPECT_THROW(b.resize(std::size_t{1} << 31), std::length_error); // the size has to fit into 31 bits
+	EXPECT_THROW(b.reserve(std::size_t{1} << 31), std::length_error);
+	EXPECT_EQ(b.size(), 100);
+}
+
+TEST(HelloTest, TestSignReference) {
+	BigInt a{5};
+	const BigInt b{-7};
+	a.sign() = b.sign();
+	EXPECT_EQ(a, BigInt{-5});
+	BigInt c{3};
+	c.sign() = a.sign(); // assigns the sign, does not rebind
+	a.sign() = Sign::POS;
+	EXPECT_EQ(c, BigInt{-3});
+	EXPECT_EQ(a.sign(), Sign::POS);
+	EXPECT_TRUE(c.sign() == Sign::NEG);
+	EXPECT_EQ(-BigInt{4} * a, BigInt{-20});
+}
+
+TEST(HelloTest, TestCompareNegative) {
+	const std::vector<std::tuple<std::string, std::string, std::strong_ordering>> values = {{
+		{"-5", "-3", std::strong_ordering::less},
+		{"-3", "-5", std::strong_ordering::greater},
+		{"-7", "-7", std::strong_ordering::equal},
+		{"-1", "0", std::strong_ordering::less},
+		{"-1", "1", std::strong_ordering::less},
+		{"-18446744073709551615", "-1", std::strong_ordering::less},
+		{"-18446744073709551616", "-18446744073709551615", std::strong_ordering::less},
+		{"-18446744073709551615", "-18446744073709551616", std::strong_ordering::greater},
+		{"-340282366920938463463374607431768211456", "-18446744073709551616", std::strong_ordering::less},
+		{"-340282366920938463463374607431768211457", "-340282366920938463463374607431768211456", std::strong_ordering::less},
+		{"-340282366920938463463374607431768211456", "-340282366920938463463374607431768211456", std::strong_ordering::equal},
+		{"-340282366920938463463374607431768211456", "340282366920938463463374607431768211456", std::strong_ordering::less},
+	}};
+	for (const auto &[a, b, expected] : values) {
+		const BigInt x{a};
+		const BigInt y{b};
+		EXPECT_EQ(x <=> y, expected) << a << " <=> " << b;
+		EXPECT_EQ(y <=> x, 0 <=> expected) << b << " <=> " << a;
+		EXPECT_EQ(x < y, expected < 0) << a << " < " << b;
+		EXPECT_EQ(x > y, expected > 0) << a << " > " << b;
+		if (b.size() < 20) { // fits into an int64_t
+			const int64_t z = std::stoll(b);
+			EXPECT_EQ(x <=> z, expected) << a << " <=> " << b;
+			EXPECT_EQ(z <=> x, 0 <=> expected) << b << " <=> " << a;
+		}
+	}
+}
+
+TEST(HelloTest, TestSmallValuesInsertFront) {
+	const BigInt a{0xFFFFFFFFFFFFFFFFull};
+	BigInt b = a + a; // 2 digits
+	b *= a;           // 3 digits
+	b.insert_front(1);
+	b.insert_front(0);
+	EXPECT_EQ(b.size(), 5);
+	EXPECT_EQ(b.__data_for_testing_only(), (std::vector<uint64_t>{0, 1, 2, 0xFFFFFFFFFFFFFFFCull, 1, 0}));
+}
+
+}
+
+
+// memory resources
+namespace {
+
+class CountingResource : public std::pmr::memory_resource {
+public:
+	std::size_t allocations = 0;
+	std::size_t live = 0;
+
+private:
+	std::pmr::monotonic_buffer_resource _arena;
+
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+		++allocations;
+		++live;
+		return _arena.allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+		--live;
+		_arena.deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+		return this == &other;
+	}
+};
+
+TEST(HelloTest, TestScopedMemoryResource) {
+	const BigInt a = 0x1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF_big;
+	const BigInt b = 0xFEDCBA0987654321FEDCBA0987654321_big;
+	const BigInt expected_sum = a + b;
+	const BigInt expected_product = a * b;
+	const auto expected_divmod = divmod(a, b);
+
+	CountingResource resource;
+	BigInt outlives_scope;
+	{
+		ScopedMemoryResource scope{&resource};
+		EXPECT_EQ(bigint::memory_resource(), &resource);
+		const BigInt sum = a + b;
+		const BigInt product = a * b;
+		const auto [d, r] = divmod(a, b);
+		EXPECT_EQ(sum, expected_sum);
+		EXPECT_EQ(product, expected_product);
+		EXPECT_EQ(d, expected_divmod.d);
+		EXPECT_EQ(r, expected_divmod.r);
+		EXPECT_GT(resource.allocations, 0);
+		{
+			ScopedMemoryResource global_heap{nullptr};
+			const auto before = resource.allocations;
+			const BigInt product2 = a * b;
+			EXPECT_EQ(resource.allocations, before);
+		}
+		outlives_scope = product;
+	}
+	EXPECT_EQ(bigint::memory_resource(), nullptr);
+	EXPECT_EQ(outlives_scope, expected_product);
+	EXPECT_EQ(resource.live, 1); // only the storage of outlives_scope
+	outlives_scope = BigInt{1};
+	EXPECT_EQ(resource.live, 0);
+}
+
+TEST(HelloTest, TestWorkspace) {
+	const BigInt mod = (1_big << 521) - 1;
+	const BigInt exp = (1_big << 300) + 12345;
+	BigInt base = 0x1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF_big;
+	const BigInt v = pow(3_big, 250);
+
+	CountingResource outputs_resource;
+	CountingResource upstream;
+	ScopedMemoryResource scope{&outputs_resource};
+	Workspace ws{&upstream};
+	BigInt product, q, r, g, power;
+
+	auto step = [&]() {
+		mult(product, base, v, ws);
+		divmod(q, r, product, mod, ws);
+		gcd(g, r, v, ws);
+		pow_mod(power, base, exp, mod, ws);
+	};
+
+	for (int i = 0; i < 3; ++i) {
+		step();
+	}
+	EXPECT_EQ(product, base * v);
+	EXPECT_EQ(q, product / mod);
+	EXPECT_EQ(r, product % mod);
+	EXPECT_EQ(g, gcd(r, v));
+	EXPECT_EQ(power, pow_mod(base, exp, mod));
+
+	const auto outputs_before = outputs_resource.allocations;
+	const auto upstream_before = upstream.allocations;
+	EXPECT_GT(upstream_before, 0);
+	for (int i = 0; i < 10; ++i) {
+		step();
+	}
+	EXPECT_EQ(outputs_resource.allocations, outputs_before);
+	EXPECT_EQ(upstream.allocations, upstream_before);
+	EXPECT_EQ(power, pow_mod(base, exp, mod));
+	BigInt root;
+	sqrt(root, product, ws);
+	EXPECT_EQ(root, sqrt(product));
+	square(root, v, ws);
+	EXPECT_EQ(root, v * v);
+}
+
+TEST(HelloTest, TestCapacityReuse) {
+	const BigInt a = pow(7_big, 200);
+	const BigInt b = pow(11_big, 150);
+	const BigInt c = pow(13_big, 100);
+
+	CountingResource resource;
+	ScopedMemoryResource scope{&resource};
+	BigInt x = a * b;
+	const auto allocations = resource.allocations;
+	x = a; // fits
+	x = c;
+	EXPECT_EQ(x, c);
+	EXPECT_EQ(resource.allocations, allocations);
+	EXPECT_GE(x.capacity(), (a * b).size());
+
+	x.shrink_to_fit();
+	EXPECT_EQ(x.capacity(), x.size());
+	EXPECT_EQ(x, c);
+	x = 5_big;
+	x.shrink_to_fit();
+	EXPECT_EQ(x.capacity(), BIGINT_INLINE_DIGITS);
+	EXPECT_EQ(x, 5);
+	x.reserve(100);
+	EXPECT_GE(x.capacity(), 100);
+	EXPECT_EQ(x, 5);
+
+	// the product is the only new value, the sum and difference reuse its storage
+	const auto before = resource.allocations;
+	const BigInt y = a * b + c - a;
+	EXPECT_LE(resource.allocations - before, 2);
+}
+
+TEST(HelloTest, TestRvalueOperators) {
+	const BigInt a = 0x1234567890ABCDEF1234567890ABCDEF_big;
+	const BigInt b{-0xFEDCBA0987654321FEDCBA0987654321FEDCBA_big};
+	for (const auto& [x, y] : {std::pair{a, b}, std::pair{b, a}, std::pair{a, a}, std::pair{BigInt{-a}, b}}) {
+		EXPECT_EQ(BigInt{x} + y, x + y);
+		EXPECT_EQ(x + BigInt{y}, x + y);
+		EXPECT_EQ(BigInt{x} + BigInt{y}, x + y);
+		EXPECT_EQ(BigInt{x} - y, x - y);
+		EXPECT_EQ(x - BigInt{y}, x - y);
+		EXPECT_EQ(BigInt{x} - BigInt{y}, x - y);
+		EXPECT_EQ(BigInt{x} + 3, x + 3);
+		EXPECT_EQ(-3 + BigInt{x}, -3 + x);
+		EXPECT_EQ(BigInt{x} - 3, x - 3);
+		EXPECT_EQ(3 - BigInt{x}, 3 - x);
+		EXPECT_EQ(BigInt{x} * -3, x * -3);
+		EXPECT_EQ(3u * BigInt{x}, 3u * x);
+	}
+	EXPECT_EQ((a - BigInt{a}).sign(), Sign::POS);
+	EXPECT_TRUE(is_zero(a - BigInt{a}));
+}
+
+}
+
+
+// expression templates
+namespace {
+
+constexpr auto
+fused_at_compile_time() -> BigInt {
+	const BigInt a{0xFFFFFFFFFFFFFFFFull};
+	const BigInt b{3};
+	return BigInt{(lazy(a) << 70) * 5 - b + a};
+}
+
+static_assert(fused_at_compile_time() == (BigInt{0xFFFFFFFFFFFFFFFFull} << 70) * 5 - BigInt{3} + BigInt{0xFFFFFFFFFFFFFFFFull});
+
+TEST(HelloTest, TestLinearCombination) {
+	std::mt19937_64 rng{16};
+	auto random = [&](std::size_t size) {
+		BigInt x;
+		x.resize(size);
+		for (auto &digit : x.digits()) {
+			digit = rng();
+		}
+		x.cleanup();
+		if (rng() % 2) {
+			x.sign() = Sign::NEG;
+		}
+		return x;
+	};
+	for (int i = 0; i < 200; ++i) {
+		const BigInt a = random(1 + rng() % 6);
+		const BigInt b = random(1 + rng() % 6);
+		const BigInt c = random(1 + rng() % 6);
+		const int64_t k = int64_t(rng()) >> (rng() % 64);
+		const uint64_t s = rng() % 200;
+		const BigInt expected = a * k + (b << s) - c;
+
+		BigInt r{lazy(a) * k + (lazy(b) << s) - c};
+		EXPECT_EQ(r, expected);
+		EXPECT_EQ(BigInt{a + lazy(b) - c}, a + b - c);
+		EXPECT_EQ(BigInt{-(lazy(a) - b)}, b - a);
+		EXPECT_EQ(BigInt{lazy(a) - a}.sign(), Sign::POS);
+		r = lazy(r) + a + b;                      // in place
+		EXPECT_EQ(r, expected + a + b);
+		r = (lazy(r) << 3) * -5 + c;              // in place
+		EXPECT_EQ(r, ((expected + a + b) << 3) * -5 + c);
+		const BigInt previous = r;
+		r = (-((lazy(r) - c) * 5) + b) << 70;     // shifted by more than a digit, evaluated in a temporary
+		EXPECT_EQ(r, (b - (previous - c) * 5) << 70);
+		r = lazy(a) + b - c + r - previous;
+		EXPECT_EQ(r, a + b - c + ((b - (previous - c) * 5) << 70) - previous);
+		r = lazy(expected) + a + b;
+		r = (lazy(r) << 65) - r;                  // reads digits behind the one being written
+		EXPECT_EQ(r, ((expected + a + b) << 65) - (expected + a + b));
+		BigInt r2 = r;
+		r = lazy(r) * -7 + bigint::_private::rshifted(r, 1); // reads ahead
+		EXPECT_EQ(r, r2 * -7 + BigInt{bigint::_private::rshifted(r2, 1)});
+	}
+	EXPECT_THROW(BigInt{lazy(BigInt{1}) * (1ull << 40) * (1ull << 40)}, std::invalid_argument);
+}
+
+constexpr auto
+fused_multiply_add_at_compile_time() -> BigInt {
+	BigInt acc{5};
+	addmul(acc, BigInt{0xFFFFFFFFFFFFFFFFull}, BigInt{0xFFFFFFFFFFFFFFFFull});
+	submul(acc, BigInt{3}, 7);
+	return acc;
+}
+
+static_assert(fused_multiply_add_at_compile_time() == BigInt{0xFFFFFFFFFFFFFFFFull} * BigInt{0xFFFFFFFFFFFFFFFFull} + BigInt{5} - BigInt{21});
+
+TEST(HelloTest, TestFusedMultiplyAdd) {
+	std::mt19937_64 rng{17};
+	auto random = [&](std::size_t size) {
+		BigInt x;
+		x.resize(size);
+		for (auto &digit : x.digits()) {
+			digit = rng();
+		}
+		x.cleanup();
+		if (rng() % 2) {
+			x.sign() = Sign::NEG;
+		}
+		return x;
+	};
+	for (int i = 0; i < 100; ++i) {
+		const std::size_t limit = (i % 10 == 0) ? 300 : 8; // some products use karatsuba
+		const BigInt a = random(1 + rng() % limit);
+		const BigInt b = random(1 + rng() % limit);
+		const BigInt m = random(1 + rng() % limit);
+		const BigInt start = random(1 + rng() % limit);
+		const int64_t k = int64_t(rng()) >> 1;
+
+		BigInt acc = start;
+		addmul(acc, a, b);
+		EXPECT_EQ(acc, start + a * b);
+		submul(acc, b, a);
+		EXPECT_EQ(acc, start);
+		addmul(acc, a, k);
+		EXPECT_EQ(acc, start + a * k);
+		submul(acc, a, k);
+		EXPECT_EQ(acc, start);
+		addmul(acc, a, ~uint64_t{0});
+		EXPECT_EQ(acc, start + a * ~uint64_t{0});
+		submul(acc, a, ~uint64_t{0});
+		EXPECT_EQ(acc, start);
+		addmul(acc, acc, b); // aliased
+		EXPECT_EQ(acc, start + start * b);
+		const BigInt previous = acc;
+		addmul(acc, bigint::_private::sliced(acc, 1, 2), b); // a view starting inside acc
+		const BigInt expected = previous + BigInt{bigint::_private::sliced(previous, 1, 2)} * b;
+		EXPECT_EQ(acc, expected);
+		submul(acc, a, bigint::_private::rshifted(acc, 1));
+		EXPECT_EQ(acc, expected - a * BigInt{bigint::_private::rshifted(expected, 1)});
+		EXPECT_EQ(mulmod(a, b, m), (a * b) % m);
+		EXPECT_EQ(mulmod(a, a, m), (a * a) % m);
+	}
+	EXPECT_THROW(static_cast<void>(mulmod(1_big, 2_big, 0_big)), std::domain_error);
+}
+
+}
+
+
+// fixed width
+namespace {
+
+using Fixed2 = FixedBigInt<2>;
+using Saturating2 = FixedBigInt<2, Overflow::SATURATE>;
+
+static_assert(sizeof(Fixed2) <= 24);
+static_assert(is_BigInt_like<Fixed2>);
+static_assert(Fixed2::max() + Fixed2{1} == Fixed2{0});
+static_assert(Saturating2::max() + Saturating2{1} == Saturating2::max());
+static_assert(Fixed2{-3} * Fixed2{5} - Fixed2{7} == Fixed2{-22});
+
+/**
+ * The exact result of an operation, reduced according to the overflow policy of N digits.
+ */
+template <std::size_t N, Overflow overflow>
+auto reduced(const BigInt &exact) -> BigInt {
+	const BigInt modulus = 1_big << (64 * N);
+	BigInt magnitude{abs(exact)};
+	if (magnitude >= modulus) {
+		magnitude = (overflow == Overflow::WRAP) ? magnitude % modulus : modulus - 1;
+	}
+	return is_neg(exact) ? BigInt{-magnitude} : magnitude;
+}
+
+template <std::size_t N, Overflow overflow>
+void check_fixed(std::mt19937_64 &rng) {
+	using Fixed = FixedBigInt<N, overflow>;
+	auto random = [&]() {
+		BigInt x;
+		x.resize(1 + rng() % N);
+		for (auto &digit : x.digits()) {
+			digit = (rng() % 4 == 0) ? ~uint64_t{0} : rng();
+		}
+		x.cleanup();
+		if (rng() % 2) {
+			x.sign() = Sign::NEG;
+		}
+		return x;
+	};
+	for (int i = 0; i < 200; ++i) {
+		const BigInt a = random();
+		const BigInt b = random();
+		const Fixed fa{a};
+		const Fixed fb{b};
+		ASSERT_EQ(BigInt{fa}, a);
+		EXPECT_EQ(BigInt{fa + fb}, (reduced<N, overflow>(a + b)));
+		EXPECT_EQ(BigInt{fa - fb}, (reduced<N, overflow>(a - b)));
+		EXPECT_EQ(BigInt{fa * fb}, (reduced<N, overflow>(a * b)));
+		EXPECT_EQ(BigInt{-fa}, BigInt{-a});
+		if (!is_zero(b)) {
+			EXPECT_EQ(BigInt{fa / fb}, a / b);
+			EXPECT_EQ(BigInt{fa % fb}, a % b);
+		}
+		EXPECT_EQ(fa + b, a + b); // mixed with BigInt, the result is a BigInt
+		EXPECT_EQ(fa < fb, a < b);
+		Fixed c = fa;
+		c += b;
+		c *= 3;
+		c -= fb;
+		EXPECT_EQ(BigInt{c}, (reduced<N, overflow>(BigInt{reduced<N, overflow>(BigInt{reduced<N, overflow>(a + b)} * 3)} - b)));
+		const BigInt wide = (b << (64 * N)) - a; // wider than N digits unless b is zero
+		Fixed d = fa;
+		d += wide;
+		EXPECT_EQ(BigInt{d}, (reduced<N, overflow>(a + wide)));
+		d = fa;
+		d -= wide;
+		EXPECT_EQ(BigInt{d}, (reduced<N, overflow>(a - wide)));
+	}
+}
+
+TEST(HelloTest, TestFixedBigInt) {
+	std::mt19937_64 rng{18};
+	check_fixed<1, Overflow::WRAP>(rng);
+	check_fixed<2, Overflow::WRAP>(rng);
+	check_fixed<4, Overflow::SATURATE>(rng);
+	check_fixed<BIGINT_FIXED_UNROLL_LIMIT + 1, Overflow::WRAP>(rng);
+	check_fixed<BIGINT_FIXED_UNROLL_LIMIT + 1, Overflow::SATURATE>(rng);
+	EXPECT_EQ(Fixed2{BigInt{1} << 130}, Fixed2{0});
+	EXPECT_EQ(Saturating2{-(BigInt{1} << 130)}, -Saturating2::max());
+	FixedBigInt<1> e{1};
+	e += -(BigInt{1} << 64); // the exact sum fits, although the operand does not
+	EXPECT_EQ(BigInt{e}, -(BigInt{1} << 64) + 1);
+	FixedBigInt<1, Overflow::SATURATE> f{1};
+	f -= BigInt{1} << 64;
+	EXPECT_EQ(BigInt{f}, -(BigInt{1} << 64) + 1);
+	EXPECT_THROW(static_cast<void>(Fixed2{1} / Fixed2{0}), std::domain_error);
+}
+
+}
+
+
+// small handle
+namespace {
+
+static_assert(sizeof(SmallBigInt) == 8);
+static_assert(is_BigInt_like<SmallBigInt>);
+static_assert(BigInt{-5} < BigInt{-3} && BigInt{-5} < -3); // the inline fast path and the BigInt path have to agree
+
+TEST(HelloTest, TestSmallBigInt) {
+	std::mt19937_64 rng{19};
+	const BigInt boundary{SmallBigInt::inline_max};
+	const BigInt lower_boundary{SmallBigInt::inline_min};
+	auto random = [&]() {
+		BigInt x;
+		switch (rng() % 4) {
+			case 0: x = BigInt{rng() % 1000}; break;
+			case 1: x = boundary - BigInt{rng() % 4}; break;
+			case 2: x = BigInt{rng()}; break;
+			default: x = BigInt{rng()} * BigInt{rng()}; break;
+		}
+		if (rng() % 2) {
+			x = -x;
+		}
+		return x;
+	};
+	auto fits_inline = [&](const BigInt &x) { return lower_boundary <= x && x <= boundary; };
+	for (int i = 0; i < 2000; ++i) {
+		const BigInt a = random();
+		const BigInt b = random();
+		const SmallBigInt sa{a};
+		const SmallBigInt sb{b};
+		ASSERT_EQ(BigInt{sa}, a);
+		ASSERT_EQ(sa.is_inline(), fits_inline(a));
+		for (const auto &[result, expected] : {
+			std::pair{sa + sb, BigInt{a + b}},
+			std::pair{sa - sb, BigInt{a - b}},
+			std::pair{sa * sb, BigInt{a * b}},
+			std::pair{-sa, BigInt{-a}},
+		}) {
+			EXPECT_EQ(BigInt{result}, expected);
+			EXPECT_EQ(result.is_inline(), fits_inline(expected)); // results that fit are stored inline again
+		}
+		if (!is_zero(b)) {
+			EXPECT_EQ(BigInt{sa / sb}, a / b);
+			EXPECT_EQ(BigInt{sa % sb}, a % b);
+		}
+		EXPECT_EQ(sa == sb, a == b);
+		EXPECT_EQ(sa <=> sb, a <=> b);
+		EXPECT_EQ(sa + b, a + b); // mixed with BigInt, the result is a BigInt
+		SmallBigInt c = sa;
+		c += b;
+		c *= 3;
+		c -= sb;
+		c /= 7;
+		EXPECT_EQ(BigInt{c}, ((a + b) * 3 - b) / 7);
+		SmallBigInt d = std::move(c);
+		c = d;
+		EXPECT_EQ(c, d);
+	}
+	SmallBigInt counter{SmallBigInt::inline_max};
+	counter += 1;
+	EXPECT_FALSE(counter.is_inline());
+	counter -= 1;
+	EXPECT_TRUE(counter.is_inline());
+	EXPECT_EQ(-SmallBigInt{SmallBigInt::inline_min}, SmallBigInt{uint64_t{1} << 62});
+	EXPECT_EQ(SmallBigInt{SmallBigInt::inline_min} / SmallBigInt{-1}, SmallBigInt{uint64_t{1} << 62});
+	EXPECT_THROW(static_cast<void>(SmallBigInt{1} / SmallBigInt{0}), std::domain_error);
+}
+
+}
+
+
+// shared values
+namespace {
+
+static_assert(is_BigInt_like<SharedBigInt>);
+static_assert(bigint::_private::has_contiguous_digits<SharedBigInt>);
+
+TEST(HelloTest, TestSharedBigInt) {
+	const BigInt modulus = (1_big << 521) - 1;
+	SharedBigInt a;
+	{
+		std::pmr::monotonic_buffer_resource resource;
+		ScopedMemoryResource scope{&resource};
+		a = SharedBigInt{(1_big << 521) - 1}; // copied to the global heap, as it outlives the resource
+	}
+	EXPECT_EQ(a, modulus);
+	{
+		std::pmr::monotonic_buffer_resource resource;
+		BigInt arena_value;
+		{
+			ScopedMemoryResource scope{&resource};
+			arena_value = (1_big << 521) - 1;
+		}
+		ASSERT_EQ(arena_value.storage_resource(), &resource);
+		const auto *const arena_digits = arena_value.digits().data();
+		const SharedBigInt d{std::move(arena_value)}; // no resource is set any more, but the digits still come from one
+		EXPECT_NE(d.digits().data(), arena_digits);
+		EXPECT_EQ(d, modulus);
+		BigInt e = modulus;
+		const auto *const heap_digits = e.digits().data();
+		EXPECT_EQ(SharedBigInt{std::move(e)}.digits().data(), heap_digits); // digits from the global heap are taken over
+	}
+
+	SharedBigInt b = a; // O(1)
+	EXPECT_EQ(a.use_count(), 2);
+	EXPECT_EQ(a.digits().data(), b.digits().data());
+	EXPECT_EQ(BigInt{-b + 1}, -modulus + 1); // usable like any BigInt-like value
+
+	b += 1; // detaches
+	EXPECT_EQ(a.use_count(), 1);
+	EXPECT_EQ(a, modulus);
+	EXPECT_EQ(b, modulus + 1);
+	const auto *const digits = b.digits().data();
+	b -= 1; // not shared, modified in place
+	EXPECT_EQ(b.digits().data(), digits);
+	EXPECT_EQ(b, a);
+
+	b += b;
+	b *= 3;
+	b %= a;
+	b <<= 2;
+	EXPECT_EQ(b, BigInt{(modulus * 6 % modulus) << 2});
+	SharedBigInt c = a;
+	c.set(0, 7);
+	c.append(1);
+	EXPECT_EQ(a, modulus);
+	EXPECT_EQ(c.size(), modulus.size() + 1);
+	c /= 5;
+	c %= 1000;
+	EXPECT_EQ(SharedBigInt{}, 0);
+
+	auto work = [a](uint64_t seed) { // each copy is shared by another thread
+		BigInt sum;
+		for (uint64_t i = 0; i < 100; ++i) {
+			SharedBigInt local = a;
+			local *= seed + i;
+			sum += local;
+		}
+		return sum;
+	};
+	std::vector<std::future<BigInt>> results;
+	for (uint64_t seed = 0; seed < 4; ++seed) {
+		results.push_back(std::async(std::launch::async, work, seed));
+	}
+	for (uint64_t seed = 0; seed < 4; ++seed) {
+		EXPECT_EQ(results[seed].get(), modulus * (100 * seed + 4950));
+	}
+	EXPECT_EQ(a, modulus);
+}
+
+}
+
+
+// division
+namespace {
+
+static_assert([] {
+	const BigInt a = (BigInt{1} << 200) + 12345;
+	const BigInt b = (BigInt{3} << 70) + 3;
+	const auto [d, r] = divmod(a, b);
+	return d * b + r == a && r < b;
+}());
+
+TEST(HelloTest, TestKnuthDivision) {
+	std::mt19937_64 rng{21};
+	auto random = [&](std::size_t n) { // digit patterns that make the quotient estimate too large now and then
+		BigInt x;
+		x.resize(n);
+		for (auto &digit : x.digits()) {
+			switch (rng() % 5) {
+				case 0: digit = 0; break;
+				case 1: digit = ~uint64_t{0}; break;
+				case 2: digit = uint64_t{1} << 63; break;
+				case 3: digit = rng() >> (rng() % 64); break;
+				default: digit = rng(); break;
+			}
+		}
+		x.set(n - 1, x[n - 1] | 1);
+		if (rng() % 2) {
+			x.sign() = Sign::NEG;
+		}
+		return x;
+	};
+	for (int i = 0; i < 3000; ++i) {
+		const std::size_t nb = 1 + rng() % 8;
+		const BigInt a = random(nb + rng() % 10);
+		const BigInt b = random(nb);
+		const auto [d, r] = divmod(a, b);
+		ASSERT_EQ(d * b + r, a);
+		EXPECT_TRUE(is_zero(r) || r.sign() == b.sign()); // the remainder has the sign of b
+		EXPECT_LT(BigInt{abs(r)}, BigInt{abs(b)});
+		EXPECT_EQ(a / b, d);
+		EXPECT_EQ(a % b, r);
+	}
+}
+
+TEST(HelloTest, TestBurnikelZieglerDivision) {
+	std::mt19937_64 rng{22};
+	auto random = [&](std::size_t n) {
+		BigInt x;
+		x.resize(n);
+		for (auto &digit : x.digits()) {
+			digit = (rng() % 4 == 0) ? ~uint64_t{0} : rng();
+		}
+		x.set(n - 1, x[n - 1] >> (rng() % 64) | 1);
+		if (rng() % 2) {
+			x.sign() = Sign::NEG;
+		}
+		return x;
+	};
+	for (const std::size_t threshold : {2, 3, 8}) {
+		for (int i = 0; i < 40; ++i) {
+			const BigInt a = random(1 + rng() % 300);
+			const BigInt b = random(1 + rng() % 150);
+			const auto expected = divmod(a, b);
+			const ScopedTuning scoped_tuning{Tuning{.burnikel_ziegler_threshold = threshold}};
+			const auto [d, r] = divmod(a, b);
+			EXPECT_EQ(d, expected.d);
+			EXPECT_EQ(r, expected.r);
+		}
+	}
+	const BigInt a = random(3000);
+	const BigInt b = random(1000);
+	const auto [d, r] = divmod(a, b); // the default threshold
+	EXPECT_EQ(d * b + r, a);
+	EXPECT_LT(BigInt{abs(r)}, BigInt{abs(b)});
+}
+
+static_assert(BarrettReducer{BigInt{7}}.reduce(BigInt{-20}) == 1);
+
+TEST(HelloTest, TestBarrettReducer) {
+	std::mt19937_64 rng{25};
+	auto random = [&](std::size_t n) {
+		BigInt x;
+		x.resize(n);
+		for (auto &digit : x.digits()) {
+			digit = (rng() % 4 == 0) ? ~uint64_t{0} : rng();
+		}
+		x.set(n - 1, x[n - 1] >> (rng() % 64) | 1);
+		if (rng() % 2) {
+			x.sign() = Sign::NEG;
+		}
+		return x;
+	};
+	for (const std::size_t karatsuba_threshold : {std::size_t{BIGINT_KARATSUBA_THRESHOLD}, std::size_t{2}}) {
+		for (int i = 0; i < 60; ++i) {
+			const BigInt m = random(1 + rng() % 12);
+			const ScopedTuning scoped_tuning{Tuning{.karatsuba_threshold = karatsuba_threshold, .ntt_threshold = 8}}; // all three methods
+			const BarrettReducer reducer{m};
+			EXPECT_EQ(reducer.modulus(), m);
+			std::vector<BigInt> values;
+			std::vector<BigInt> remainders;
+			for (int j = 0; j < 10; ++j) {
+				const BigInt x = random(1 + rng() % 40);
+				const auto [d, r] = divmod(x, m);
+				const auto result = reducer.divmod(x);
+				EXPECT_EQ(result.d, d);
+				EXPECT_EQ(result.r, r);
+				EXPECT_EQ(x % reducer, r);
+				values.push_back(x);
+				remainders.push_back(r);
+			}
+			reducer.reduce(values);
+			EXPECT_EQ(values, remainders);
+			const BigInt base = random(1 + rng() % 12);
+			const BigInt exp = BigInt{abs(random(1 + rng() % 2))};
+			EXPECT_EQ(pow_mod(base, exp, reducer), pow_mod(base, exp, m));
+			EXPECT_EQ(mulmod(base, values[0], reducer), mulmod(base, values[0], m));
+		}
+	}
+	EXPECT_THROW(BarrettReducer{BigInt{0}}, std::domain_error);
+}
+
+static_assert(MontgomeryContext{BigInt{13}}.pow(BigInt{2}, BigInt{10}) == 10);
+
+TEST(HelloTest, TestMontgomeryContext) {
+	std::mt19937_64 rng{26};
+	auto random = [&](std::size_t n) {
+		BigInt x;
+		x.resize(n);
+		for (auto &digit : x.digits()) {
+			digit = (rng() % 4 == 0) ? ~uint64_t{0} : rng();
+		}
+		x.set(n - 1, x[n - 1] >> (rng() % 64) | 1);
+		if (rng() % 2) {
+			x.sign() = Sign::NEG;
+		}
+		return x;
+	};
+	for (int i = 0; i < 200; ++i) {
+		BigInt m = random(1 + rng() % 12);
+		m.set(0, m[0] | 1);
+		const MontgomeryContext context{m};
+		EXPECT_EQ(context.modulus(), m);
+		const BigInt magnitude{abs(m)};
+		const BigInt a = random(1 + rng() % 24);
+		const BigInt b = random(1 + rng() % 24);
+		const BigInt a_mont = context.to_montgomery(a);
+		EXPECT_LT(a_mont, magnitude);
+		EXPECT_EQ(context.from_montgomery(a_mont), BigInt{a % magnitude});
+		EXPECT_EQ(context.from_montgomery(context.mult(a_mont, context.to_montgomery(b))), BigInt{(a * b) % magnitude});
+
+		const BigInt exp = BigInt{abs(random(1 + rng() % 3))};
+		const BigInt expected = pow_mod(a, exp, BarrettReducer{m});
+		EXPECT_EQ(pow_mod(a, exp, context), expected);
+		EXPECT_EQ(pow_mod(a, exp, m), expected); // odd moduli use Montgomery multiplication by default
+		{
+			const ScopedTuning scoped_tuning{Tuning{.montgomery_threshold = 1}};
+			EXPECT_EQ(pow_mod(a, exp, m), expected); // Barrett reduction
+		}
+	}
+	EXPECT_EQ(pow_mod(BigInt{7}, BigInt{0}, MontgomeryContext{BigInt{9}}), BigInt{1});
+	EXPECT_EQ(pow_mod(BigInt{7}, BigInt{5}, MontgomeryContext{BigInt{1}}), BigInt{0});
+	EXPECT_EQ(MontgomeryContext{BigInt{7}}.pow(BigInt{2}, BigInt{0}), BigInt{1});
+	EXPECT_EQ(MontgomeryContext{BigInt{-7}}.pow(BigInt{2}, BigInt{0}), BigInt{-6}); // the result has the sign of the modulus
+	EXPECT_EQ(MontgomeryContext{BigInt{1}}.pow(BigInt{2}, BigInt{0}), BigInt{0});
+	EXPECT_EQ(MontgomeryContext{BigInt{7}}.pow(BigInt{3}, BigInt{1}), BigInt{3});
+	EXPECT_THROW(static_cast<void>(MontgomeryContext{BigInt{7}}.pow(BigInt{2}, BigInt{-3})), std::domain_error);
+	EXPECT_THROW(static_cast<void>(MontgomeryContext{BigInt{7}}.pow(BigInt{0}, BigInt{0})), std::domain_error);
+	EXPECT_THROW(MontgomeryContext{BigInt{10}}, std::domain_error);
+	EXPECT_THROW(MontgomeryContext{BigInt{0}}, std::domain_error);
+}
+
+static_assert(reciprocal(BigInt{3}, 1) == BigInt{0x5555555555555555});
+
+TEST(HelloTest, TestReciprocal) {
+	std::mt19937_64 rng{23};
+	for (int i = 0; i < 300; ++i) {
+		const std::size_t n = 1 + rng() % 40;
+		BigInt d;
+		d.resize(n);
+		for (auto &digit : d.digits()) {
+			digit = (rng() % 4 == 0) ? ~uint64_t{0} : rng();
+		}
+		d.set(n - 1, d[n - 1] >> (rng() % 64) | 1);
+		if (rng() % 8 == 0) {
+			d = BigInt{1} << (64 * (n - 1) + rng() % 64); // x = 2^(64 k) / d is exact, the largest x for its size
+		}
+		if (rng() % 2) {
+			d.sign() = Sign::NEG;
+		}
+		const std::size_t k = rng() % 120;
+		EXPECT_EQ(reciprocal(d, k), (BigInt{1} << 64 * k) / d);
+	}
+	EXPECT_EQ(reciprocal(BigInt{1}, 2), BigInt{1} << 128);
+	EXPECT_EQ(reciprocal(BigInt{-1}, 2), BigInt{-1} << 128);
+	EXPECT_EQ(reciprocal(BigInt{1} << 130, 2), BigInt{0});
+	EXPECT_EQ(reciprocal(BigInt{-1} << 130, 2), BigInt{-1});
+	EXPECT_THROW(static_cast<void>(reciprocal(BigInt{0}, 1)), std::domain_error);
+}
+
+TEST(HelloTest, TestNewtonDivision) {
+	std::mt19937_64 rng{24};
+	auto random = [&](std::size_t n) {
+		BigInt x;
+		x.resize(n);
+		for (auto &digit : x.digits()) {
+			digit = (rng() % 4 == 0) ? ~uint64_t{0} : rng();
+		}
+		x.set(n - 1, x[n - 1] >> (rng() % 64) | 1);
+		if (rng() % 2) {
+			x.sign() = Sign::NEG;
+		}
+		return x;
+	};
+	for (const std::size_t threshold : {1, 5, 20}) {
+		for (int i = 0; i < 40; ++i) {
+			const BigInt a = random(1 + rng() % 400);
+			const BigInt b = (rng() % 8 == 0) ? BigInt{1} << (64 * (rng() % 100)) : random(1 + rng() % 200);
+			const auto expected = divmod(a, b);
+			const ScopedTuning scoped_tuning{Tuning{.burnikel_ziegler_threshold = 2 + rng() % 8, .newton_threshold = threshold}};
+			const auto [d, r] = divmod(a, b);
+			EXPECT_EQ(d, expected.d);
+			EXPECT_EQ(r, expected.r);
+		}
+	}
+}
+
+}
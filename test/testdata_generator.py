@@ -2,6 +2,8 @@
 from dataclasses import dataclass
 import itertools as it
 import math
+import random
+import sys
 from operator import itemgetter
 from typing import Callable, ClassVar, Iterable
 
@@ -219,6 +221,7 @@ BINARY_ARITHMETIC_OPERATIONS: list[Operation] = [
 	BinOperation('add',    lambda a, b:    a + b),
 	BinOperation('sub',    lambda a, b:    a - b),
 	BinOperation('mul',    lambda a, b:    a * b),
+	UnaOperation('square', lambda a:       a * a),
 	BinOperation('div',    lambda a, b:    a // b,                   lambda a, b:    b != 0),
 	BinOperation('mod',    lambda a, b:    a % b,                    lambda a, b:    b != 0),
 	BinOperation('divmod', lambda a, b:    f'{a // b}|{a % b}',      lambda a, b:    b != 0),
@@ -299,9 +302,41 @@ def select_all_arguments(operation: Operation) -> list[tuple[Arg, ...]]:
 		case _: raise ValueError(f"unhandeled param_count: {param_count!r}")
 
 
-def make_values_for_test_csv(operation: Operation) -> tuple[str, str]:
+# values with many digits in base 2^64. Used to test the algorithms that are only selected for large operands (e.g. Karatsuba multiplication).
+_large_values_rng = random.Random(0x5eed)
+
+def random_digits(digit_count: int) -> int:
+	""" a random value with exactly `digit_count` digits in base 2^64. """
+	return _large_values_rng.getrandbits(64 * digit_count) | (1 << (64 * digit_count - 1))
+
+LARGE_UNIQUE_VALUES_SIGNED: list[int] = [
+		UINT64_MAX_00,
+		2**(64*40) - 1,  # all digits set, usful for testing carry overflow
+		2**(64*129) - 1,
+		2**(64*70),
+		-random_digits(3),
+		random_digits(17),
+		random_digits(33),
+		-random_digits(64),
+		random_digits(65),
+		random_digits(150),
+		random_digits(257),
+		-random_digits(400),
+]
+
+LARGE_UNIQUE_ARGUMENTS: list[Arg] = [Arg(i, arg) for i, arg in enumerate(LARGE_UNIQUE_VALUES_SIGNED)]
+LARGE_UNA_ARGUMENTS: list[tuple[Arg]] = list(it.product(LARGE_UNIQUE_ARGUMENTS))
+LARGE_BIN_ARGUMENTS: list[tuple[Arg, Arg]] = list(it.product(LARGE_UNIQUE_ARGUMENTS, LARGE_UNIQUE_ARGUMENTS))
+
+LARGE_ARITHMETIC_OPERATIONS: list[Operation] = [
+	BinOperation('mul_large',    lambda a, b:    a * b),
+	UnaOperation('square_large', lambda a:       a * a),
+]
+
+
+def make_values_for_test_csv(operation: Operation, all_args: list[tuple[Arg, ...]] | None = None) -> tuple[str, str]:
 	lines = make_ALL_TEST_VALUES(
-			select_all_arguments(operation),
+			all_args if all_args is not None else select_all_arguments(operation),
 			operation
 		)
 	return (
@@ -313,12 +348,15 @@ def make_values_for_test_csv(operation: Operation) -> tuple[str, str]:
 def make_values_for_test_csvs() -> list[tuple[str, str]]:
 	files = [
 		*map(make_values_for_test_csv, BINARY_ARITHMETIC_OPERATIONS),
+		*(make_values_for_test_csv(operation, LARGE_UNA_ARGUMENTS if operation.param_count == 1 else LARGE_BIN_ARGUMENTS) for operation in LARGE_ARITHMETIC_OPERATIONS),
 	]
 
 	return files;
 
 
 if __name__ == "__main__":
+	if hasattr(sys, 'set_int_max_str_digits'):
+		sys.set_int_max_str_digits(0)  # the large values have way more than 4300 decimal digits.
 	files = make_values_for_test_csvs()
 	# print(values_for_test_h)
 	for name, content in files:
@@ -197,7 +197,7 @@ param_type() {
 	} else if constexpr (std::is_same_v<bigint::BigInt, T>) {
 		return PT::BIG;
 	} else {
-		static_assert(false, "unhandeled type provided");
+		static_assert(!sizeof(T), "unhandeled type provided");
 	}
 }
 
@@ -222,7 +222,7 @@ str_to_int(const std::string_view str_value) {
 		auto r = str_value.substr(delimiter + 1);
 		return bigint::DivModResult{str_to_int<typename T::_D>(d), str_to_int<typename T::_R>(r)};
 	} else {
-		static_assert(false, "unhandeled type provided");
+		static_assert(!sizeof(T), "unhandeled type provided");
 	}
 }
 
@@ -40,6 +40,9 @@ DECLARE_LOAD_TESTDATA_FUNC(rshift, 2)
 DECLARE_LOAD_TESTDATA_FUNC(add, 2)
 DECLARE_LOAD_TESTDATA_FUNC(sub, 2)
 DECLARE_LOAD_TESTDATA_FUNC(mul, 2)
+DECLARE_LOAD_TESTDATA_FUNC(mul_large, 2)
+DECLARE_LOAD_TESTDATA_FUNC(square, 1)
+DECLARE_LOAD_TESTDATA_FUNC(square_large, 1)
 DECLARE_LOAD_TESTDATA_FUNC(div, 2)
 DECLARE_LOAD_TESTDATA_FUNC(mod, 2)
 DECLARE_LOAD_TESTDATA_FUNC(divmod, 2)